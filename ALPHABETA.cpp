@@ -2,22 +2,128 @@
 #include "DEFINITION.hpp"
 #include "EVALUATION.hpp"
 #include "GAMESTATE.hpp"
+#include "MOVEPICKER.hpp"
 #include "TRANSPOSITIONTABLE.hpp"
 #include <algorithm>
 #include <assert.h>
 #include <chrono>
 #include <limits.h>
+#include <math.h>
 #include <stdio.h>
-#include <vector>
+#include <thread>
+
+AlphaBeta::AlphaBeta(GameState& gameState, const SearchConfig& config)
+    : config(config), rootState(gameState), gameState(&gameState), ownTranspositionTable(new TranspositionTable()),
+    ownTimeManager(new TimeManager(config.timeLimit)), transpositionTable(ownTranspositionTable.get()), timeManager(ownTimeManager.get()),
+    stop(&stopSignal), sharedNodes(&searchedNodes) {
+    history.setButterfly(config.butterflyHistory);
+
+    for (int depth = 1; depth < MAX_PLY; ++depth) {
+        for (int moveCount = 1; moveCount < MAX_MOVES; ++moveCount) {
+            const double reduction = config.lmrBase + log((double)depth) * log((double)moveCount) / config.lmrDivisor;
+            reductions[depth][moveCount] = (reduction > 0) ? (int)reduction : 0;
+        }
+    }
+
+    SearchConfig helperConfig = config;
+    helperConfig.threads = 1;
+
+    if (config.threads > 1 && config.parallelMode == ABDADA) {
+        ownSearchingMoves.reset(new SearchingMoves());
+        searchingMoves = ownSearchingMoves.get();
+    }
+
+    for (int index = 1; index < config.threads; ++index) { //Der Helfer-Konstruktor ist privat, daher kein make_unique
+        helpers.push_back(std::unique_ptr<AlphaBeta>(new AlphaBeta(gameState, helperConfig, *this, index)));
+    }
+}
+
+AlphaBeta::AlphaBeta(GameState& gameState, const SearchConfig& config, AlphaBeta& main, const int threadIndex)
+    : config(config), rootState(gameState), gameState(&gameState), transpositionTable(main.transpositionTable),
+    timeManager(main.timeManager), searchingMoves(main.searchingMoves), stop(&main.stopSignal),
+    sharedNodes(&main.searchedNodes), threadIndex(threadIndex) {
+    history.setButterfly(config.butterflyHistory);
+
+    for (int depth = 0; depth < MAX_PLY; ++depth) {
+        for (int moveCount = 0; moveCount < MAX_MOVES; ++moveCount) {
+            reductions[depth][moveCount] = main.reductions[depth][moveCount];
+        }
+    }
+}
+
+AlphaBeta::~AlphaBeta() {
+    stopPondering(); //Die Helfer und die geteilten Objekte werden danach von den unique_ptr freigegeben
+}
+
+void AlphaBeta::recordSend(const Time sent) {
+    timeManager->recordSend(sent);
+}
+
+uint64_t AlphaBeta::getNodes() const {
+    uint64_t sum = nodes;
+    for (const std::unique_ptr<AlphaBeta>& helper : helpers) sum += helper->nodes;
+
+    return sum;
+}
+
+#ifdef SEARCH_STATS
+void SearchStats::add(const SearchStats& other) {
+    qnodes += other.qnodes;
+    ttProbes += other.ttProbes;
+    ttHits += other.ttHits;
+    ttCutoffs += other.ttCutoffs;
+    nullMoveCutoffs += other.nullMoveCutoffs;
+
+    for (int i = 0; i < CUTOFF_INDEX_COUNT; ++i) cutoffs[i] += other.cutoffs[i];
+}
+
+double percent(const uint64_t part, const uint64_t total) {
+    return (total == 0) ? 0.0 : 100.0 * (double)part / (double)total;
+}
+
+void SearchStats::print(const bool ponder, const uint64_t nodes, const int time) const {
+    uint64_t cutoffSum = 0;
+    for (int i = 0; i < CUTOFF_INDEX_COUNT; ++i) cutoffSum += cutoffs[i];
+
+    //Effektiver Verzweigungsfaktor: Knoten der letzten Iteration geteilt durch die der vorletzten
+    const uint64_t last = (depth >= 1) ? iterationNodes[depth] - iterationNodes[depth - 1] : 0;
+    const uint64_t previous = (depth >= 2) ? iterationNodes[depth - 1] - iterationNodes[depth - 2] : 0;
+    const double ebf = (previous == 0) ? 0.0 : (double)last / (double)previous;
+
+    printf("STATS: ponder=%i depth=%i time=%ims nodes=%llu qnodes=%llu (%.1f%%) tt_probes=%llu tt_hits=%.1f%% tt_cutoffs=%.1f%% null_cutoffs=%llu"
+        " cutoffs=%llu first=%.1f%% by_index=",
+        ponder, depth, time, (unsigned long long)nodes, (unsigned long long)qnodes, percent(qnodes, nodes),
+        (unsigned long long)ttProbes, percent(ttHits, ttProbes), percent(ttCutoffs, ttProbes), (unsigned long long)nullMoveCutoffs,
+        (unsigned long long)cutoffSum, percent(cutoffs[0], cutoffSum));
 
-AlphaBeta::AlphaBeta(GameState& gameState) : gameState(gameState) {}
+    for (int i = 0; i < CUTOFF_INDEX_COUNT; ++i) printf(i == 0 ? "%llu" : ",%llu", (unsigned long long)cutoffs[i]);
+
+    printf(" ebf=%.2f iterations=", ebf);
+
+    for (int d = 1; d <= depth; ++d) { //Tiefe:Knoten/QKnoten/Millisekunden, nur Hauptthread
+        printf(d == 1 ? "%i:%llu/%llu/%i" : ",%i:%llu/%llu/%i", d,
+            (unsigned long long)(iterationNodes[d] - iterationNodes[d - 1]),
+            (unsigned long long)(iterationQNodes[d] - iterationQNodes[d - 1]),
+            iterationTime[d] - iterationTime[d - 1]);
+    }
+
+    printf("\n");
+}
+#endif
 
 bool AlphaBeta::checkTimeOut() {
     assert(!timeOut);
 
-    Time now = std::chrono::system_clock::now();
+    if (nodes - polledNodes < (uint64_t)config.stopPollNodes) return false;
 
-    if (std::chrono::duration_cast<MS>(now - start).count() >= 1950) {
+    const uint64_t searched = nodes - polledNodes;
+    polledNodes = nodes;
+
+    if (config.nodeLimit != 0 && sharedNodes->fetch_add(searched, std::memory_order_relaxed) + searched >= config.nodeLimit) {
+        stop->store(true, std::memory_order_relaxed);
+    }
+
+    if (stop->load(std::memory_order_relaxed)) {
         timeOut = true;
         return true;
     }
@@ -25,46 +131,102 @@ bool AlphaBeta::checkTimeOut() {
     return false;
 }
 
-bool isTacticalMove(const GameState& gameState, const Move& move) {
-    const Field& to = gameState.board[move.to.square];
-    if (to.occupied) return true;
+template<Team team>
+SaveState AlphaBeta::makeMove(const Move& move) {
+#ifdef COPY_MAKE
+    assert(gameState + 1 < positions + MAX_PLY + 1);
 
-    const Field& from = gameState.board[move.from.square];
-    const int oppBaseline = (from.team == ONE) ? 7 : 0;
-    if (from.pieceType == ROBBE && move.to.coords.x == oppBaseline) return true;
+    gameState[1] = gameState[0];
+    ++gameState;
+    gameState->makeMove<team>(move);
 
-    const Direction forward = (from.team == ONE) ? RIGHT : LEFT;
-    const Field& front = gameState.board[move.from.square + forward];
-    if (from.pieceType == HERZMUSCHEL && front.pieceType == MOEWE
-        && front.team != from.team) return true;
+    return {};
+#else
+    return gameState->makeMove<team>(move);
+#endif
+}
 
-    return false;
+template<Team team>
+void AlphaBeta::unmakeMove(const Move& move, const SaveState& saveState) {
+#ifdef COPY_MAKE
+    (void)move; //Die Kopie auf der vorigen Ply ist noch unverndert
+    (void)saveState;
+    assert(gameState > positions);
+
+    --gameState;
+#else
+    gameState->unmakeMove<team>(move, saveState);
+#endif
+}
+
+void AlphaBeta::makeNullMove() {
+#ifdef COPY_MAKE
+    assert(gameState + 1 < positions + MAX_PLY + 1);
+
+    gameState[1] = gameState[0];
+    ++gameState;
+    gameState->makeNullMove();
+#else
+    gameState->makeNullMove();
+#endif
+}
+
+void AlphaBeta::unmakeNullMove() {
+#ifdef COPY_MAKE
+    assert(gameState > positions);
+
+    --gameState;
+#else
+    gameState->unmakeNullMove();
+#endif
 }
 
+bool AlphaBeta::isNullMoveAllowed(const int depth, const int alpha, const int beta) const {
+    if (!config.nullMove || depth < NULL_MOVE_MIN_DEPTH) return false;
+    if (beta - alpha > 1) return false; //Nur mit Nullfenster, die Hauptvariante wird voll gesucht
+    if (beta >= WINNING_SCORE || beta <= -WINNING_SCORE) return false;
+
+    //Am Zuglimit entscheiden die Entfernungen der Spielsteine, ein ausgelassener Zug verflscht dann das Ergebnis
+    if (gameState->turn + depth >= TURN_LIMIT) return false;
+
+    //Ein Punkt vor MAX_SCORE entscheidet jeder Punkt die Partie, dort ist Zugzwang mglich
+    for (int team = 0; team < TEAM_COUNT; ++team) {
+        if (gameState->score[team] >= MAX_SCORE - 1) return false;
+    }
+
+    return Evaluation::evaluate(*gameState, false) >= beta;
+}
+
+template<Team team>
 int AlphaBeta::quiesce(int alpha, int beta) {
     assert(alpha < beta);
-    assert(!gameState.isOver());
+    assert(!gameState->isOver());
+
+    ++nodes;
+    SEARCH_STAT(++stats.qnodes);
 
     if (checkTimeOut()) return 0;
 
-    int static_evaluation = Evaluation::evaluate(gameState, false);
+    int static_evaluation = Evaluation::evaluate(*gameState, false);
 
     if (static_evaluation >= beta) return beta;
     if (alpha < static_evaluation) alpha = static_evaluation;
 
-    std::vector<Move> moves = gameState.getPossibleMoves();
-    if (moves.size() == 0) return -WINNING_SCORE;
+    if (!gameState->hasMoves<team>()) return -WINNING_SCORE;
+
+    MoveList moves;
+    gameState->generateTactical<team>(moves);
 
-    for (const Move& move : moves) {
-        if (!isTacticalMove(gameState, move)) continue;
+    for (const MoveValuePair& entry : moves) {
+        const Move& move = entry.move;
 
-        SaveState saveState = gameState.makeMove(move);
+        SaveState saveState = makeMove<team>(move);
 
         int score;
-        if (gameState.isOver()) score = -Evaluation::evaluate(gameState, true);
-        else score = -quiesce(-beta, -alpha);
+        if (gameState->isOver()) score = -Evaluation::evaluate(*gameState, true);
+        else score = -quiesce<TeamTraits<team>::opp>(-beta, -alpha);
 
-        gameState.unmakeMove(move, saveState);
+        unmakeMove<team>(move, saveState);
 
         if (timeOut) return 0;
 
@@ -75,25 +237,94 @@ int AlphaBeta::quiesce(int alpha, int beta) {
     return alpha;
 }
 
-int AlphaBeta::alphaBeta(const int depth, int alpha, int beta) {
+void AlphaBeta::updatePv(const int ply, const Move& move) {
+    assert(pvLength[ply + 1] >= ply + 1);
+
+    pvTable[ply][ply] = move;
+    for (int i = ply + 1; i < pvLength[ply + 1]; ++i) pvTable[ply][i] = pvTable[ply + 1][i];
+
+    pvLength[ply] = pvLength[ply + 1];
+}
+
+void AlphaBeta::printPv() const {
+    for (int i = 0; i < pvSize; ++i) {
+        printf(" (%i, %i) -> (%i, %i)", pv[i].from().coords.x, pv[i].from().coords.y, pv[i].to().coords.x, pv[i].to().coords.y);
+    }
+}
+
+bool AlphaBeta::deferMove(const Move& move, const int depth, const int moveCount, Move* deferred, int& deferredCount) const {
+    if (searchingMoves == nullptr || moveCount == 0) return false; //Der erste Zug wird nie zurckgestellt
+    if (!searchingMoves->isSearching(SearchingMoves::moveHash(gameState->hash, move), depth)) return false;
+
+    assert(deferredCount < MAX_MOVES);
+
+    deferred[deferredCount++] = move;
+    return true;
+}
+
+template<Team team>
+int AlphaBeta::searchMove(const int depth, const int alpha, const int beta, const bool first, const int reduction) {
+    assert(reduction >= 0 && reduction < depth);
+
+    if (first) return -alphaBeta<TeamTraits<team>::opp>(depth - 1, -beta, -alpha);
+
+    int score;
+
+    //Ein reduzierter Zug soll nur zeigen, dass er nicht besser als alpha ist. Gelingt das nicht, wird mit voller Tiefe gesucht.
+    if (reduction > 0) {
+        score = -alphaBeta<TeamTraits<team>::opp>(depth - 1 - reduction, -alpha - 1, -alpha);
+        if (score <= alpha || timeOut) return score;
+    }
+
+    //Dasselbe mit voller Tiefe. Nur wenn der Zug zwischen alpha und beta liegt, wird mit vollem Fenster erneut gesucht.
+    if (config.pvs) {
+        score = -alphaBeta<TeamTraits<team>::opp>(depth - 1, -alpha - 1, -alpha);
+        if (score <= alpha || score >= beta || timeOut) return score;
+    }
+
+    return -alphaBeta<TeamTraits<team>::opp>(depth - 1, -beta, -alpha);
+}
+
+template<Team team>
+int AlphaBeta::alphaBeta(const int depth, int alpha, int beta, const bool allowNullMove) {
     assert(depth >= 0);
     assert(alpha < beta);
 
+    ++nodes;
+
+    const int ply = gameState->turn - rootTurn;
+    assert(ply > 0 && ply < MAX_PLY);
+
+    pvLength[ply] = ply;
+    pvNode[ply] = ply - 1 < pvSize && pvNode[ply - 1] && moveStack[ply - 1] == pv[ply - 1];
+
     if (checkTimeOut()) return 0;
 
-    Transposition transposition = transpositionTable.get(gameState.hash);
+    Transposition transposition = transpositionTable->get(gameState->hash);
+
+    SEARCH_STAT(++stats.ttProbes);
+    SEARCH_STAT(stats.ttHits += (transposition.type != EMPTY));
 
     if (transposition.type != EMPTY && transposition.depth >= depth) {
-        if (transposition.type == EXACT) return transposition.score;
+        if (transposition.type == EXACT) {
+            SEARCH_STAT(++stats.ttCutoffs);
+            return transposition.score;
+        }
 
         if (transposition.type == ALPHA) {
-            if (transposition.score <= alpha) return alpha;
+            if (transposition.score <= alpha) {
+                SEARCH_STAT(++stats.ttCutoffs);
+                return alpha;
+            }
 
             if (transposition.depth == depth && transposition.score < beta)
                 beta = transposition.score;
         }
         else if (transposition.type == BETA) {
-            if (transposition.score >= beta) return beta;
+            if (transposition.score >= beta) {
+                SEARCH_STAT(++stats.ttCutoffs);
+                return beta;
+            }
 
             if (transposition.depth == depth && transposition.score > alpha)
                 alpha = transposition.score;
@@ -102,116 +333,377 @@ int AlphaBeta::alphaBeta(const int depth, int alpha, int beta) {
 
     assert(alpha < beta);
 
-    if (gameState.isOver()) return Evaluation::evaluate(gameState, true);
-    if (depth <= 0) return quiesce(alpha, beta);
+    if (gameState->isOver()) return Evaluation::evaluate(*gameState, true);
+    if (depth <= 0) return quiesce<team>(alpha, beta);
 
-    TranspositionType type = ALPHA;
-    Move bestMove;
+    if (allowNullMove && isNullMoveAllowed(depth, alpha, beta)) {
+        const int nullDepth = std::max(depth - 1 - config.nullMoveReduction, 0);
+
+        moveStack[ply] = Move{};
 
-    if (transposition.type == EXACT || transposition.type == BETA) {
-        SaveState saveState = gameState.makeMove(transposition.move);
-        int score = -alphaBeta(depth - 1, -beta, -alpha);
-        gameState.unmakeMove(transposition.move, saveState);
+        makeNullMove();
+        int score = -alphaBeta<TeamTraits<team>::opp>(nullDepth, -beta, -beta + 1, false); //Zwei Null Moves hintereinander gibt es nicht
+        unmakeNullMove();
 
         if (timeOut) return 0;
 
+        if (score >= beta && config.nullMoveVerification) {
+            score = alphaBeta<team>(std::max(depth - config.nullMoveReduction, 0), beta - 1, beta, false);
+            if (timeOut) return 0;
+        }
+
         if (score >= beta) {
-            transpositionTable.put({ BETA, gameState.hash, depth, beta, transposition.move, gameState.turn });
+            SEARCH_STAT(++stats.nullMoveCutoffs);
             return beta;
         }
+    }
 
-        if (score > alpha) {
-            type = EXACT;
-            bestMove = transposition.move;
-            alpha = score;
+    TranspositionType type = ALPHA;
+    Move bestMove;
+
+    const Move ttMove = (transposition.type == EXACT || transposition.type == BETA) ? transposition.move : Move{};
+    const Move firstMove = (pvNode[ply] && ply < pvSize) ? pv[ply] : ttMove; //Auf der Hauptvariante der vorigen Iteration wird deren Zug zuerst gesucht
+    const Move previousMove = (ply > 0) ? moveStack[ply - 1] : Move{};
+    Move& counterMove = counterMoves[previousMove.from().square][previousMove.to().square];
+
+    MovePicker movePicker{ *gameState, firstMove, killers[ply], config.counterMoves ? counterMove : Move{}, history };
+
+    int moveCount = 0;
+    Move move;
+
+    Move quiets[MAX_MOVES]; //Bisher gesuchte ruhige Zge, sie werden bei einem Beta-Cutoff in der History abgewertet
+    int quietCount = 0;
+
+    Move deferred[MAX_MOVES]; //ABDADA: Zge, die beim ersten Durchlauf ein anderer Thread gesucht hat
+    int deferredCount = 0;
+    int deferredIndex = 0;
+
+    while (true) {
+        move = movePicker.next<team>();
+
+        if (move == Move{}) { //Danach die zurckgestellten Zge, diesmal ohne erneute Prfung
+            if (deferredIndex == deferredCount) break;
+            move = deferred[deferredIndex++];
         }
-    }
+        else if (deferMove(move, depth, moveCount, deferred, deferredCount)) continue;
+
+        ++moveCount;
 
-    std::vector<Move> moves = gameState.getPossibleMoves();
+        const bool quiet = !gameState->isTacticalMove<team>(move);
+
+        //Spte ruhige Zge werden reduziert, nicht aber der TT-Zug und Killer
+        int reduction = 0;
+        if (config.lmr && depth >= LMR_MIN_DEPTH && moveCount > LMR_MIN_MOVES && quiet && move != ttMove
+            && move != killers[ply][0] && move != killers[ply][1]) {
+            reduction = std::min(reductions[std::min(depth, MAX_PLY - 1)][std::min(moveCount, MAX_MOVES - 1)], depth - 1); //maxDepth ist nicht an MAX_PLY gebunden
+        }
 
-    if (moves.size() == 0) return -WINNING_SCORE;
+        moveStack[ply] = move;
 
-    std::sort(moves.begin(), moves.end(), [&](const Move& a, const Move& b) {
-        return history[gameState.board[a.from.square].pieceType][a.to.square]
-    > history[gameState.board[b.from.square].pieceType][b.to.square];
-        });
+        const uint64_t moveHash = SearchingMoves::moveHash(gameState->hash, move);
+        if (searchingMoves != nullptr) searchingMoves->start(moveHash, depth);
 
-    for (Move move : moves) {
-        if (transposition.move == move) continue;
+        SaveState saveState = makeMove<team>(move);
+        int score = searchMove<team>(depth, alpha, beta, moveCount == 1, reduction);
+        unmakeMove<team>(move, saveState);
 
-        SaveState saveState = gameState.makeMove(move);
-        int score = -alphaBeta(depth - 1, -beta, -alpha);
-        gameState.unmakeMove(move, saveState);
+        if (searchingMoves != nullptr) searchingMoves->finish(moveHash, depth);
 
         if (timeOut) return 0;
 
         if (score >= beta) {
-            transpositionTable.put({ BETA, gameState.hash, depth, beta, move, gameState.turn });
-            history[gameState.board[move.from.square].pieceType][move.to.square] += 1 << depth;
+            SEARCH_STAT(stats.addCutoff(moveCount));
+
+            transpositionTable->put({ BETA, gameState->hash, depth, beta, move, gameState->turn });
+
+            if (quiet) {
+                const int bonus = depth * depth;
+
+                history.update(*gameState, team, move, bonus);
+                for (int i = 0; i < quietCount; ++i) history.update(*gameState, team, quiets[i], -bonus);
+
+                if (killers[ply][0] != move) {
+                    killers[ply][1] = killers[ply][0];
+                    killers[ply][0] = move;
+                }
+
+                if (previousMove != Move{}) counterMove = move;
+            }
+
             return beta;
         }
 
+        if (quiet) quiets[quietCount++] = move;
+
         if (score > alpha) {
             type = EXACT;
             bestMove = move;
             alpha = score;
+            updatePv(ply, move);
         }
     }
 
-    transpositionTable.put({ type, gameState.hash, depth, alpha, bestMove, gameState.turn });
+    if (moveCount == 0) return -WINNING_SCORE;
+
+    transpositionTable->put({ type, gameState->hash, depth, alpha, bestMove, gameState->turn });
 
     return alpha;
 }
 
+template<Team team>
 MoveValuePair AlphaBeta::alphaBetaRoot(const int depth, int alpha, int beta) {
     assert(depth > 0);
     assert(alpha < beta);
+    assert(rootMoves.size != 0);
+
+    pvLength[0] = 0;
+    pvNode[0] = true;
 
     if (checkTimeOut()) return {};
 
-    std::vector<Move> moves = gameState.getPossibleMoves();
+    TranspositionType type = ALPHA;
+    Move bestMove = rootMoves.moves[0].move;
+
+    Move deferred[MAX_MOVES];
+    int deferredCount = 0;
+    int moveCount = 0;
 
-    assert(moves.size() != 0);
+    for (int i = 0; i < rootMoves.size + deferredCount; ++i) { //Die zurckgestellten Zge hinter der Liste
+        RootMove& rootMove = (i < rootMoves.size) ? rootMoves.moves[i] : *rootMoves.find(deferred[i - rootMoves.size]);
+        const Move move = rootMove.move;
 
-    Move bestMove = moves[0];
+        if (i < rootMoves.size && deferMove(move, depth, moveCount, deferred, deferredCount)) continue;
 
-    for (Move move : moves) {
-        SaveState saveState = gameState.makeMove(move);
-        int score = -alphaBeta(depth - 1, -beta, -alpha);
-        gameState.unmakeMove(move, saveState);
+        ++moveCount;
+        moveStack[0] = move;
+
+        const uint64_t moveHash = SearchingMoves::moveHash(gameState->hash, move);
+        if (searchingMoves != nullptr) searchingMoves->start(moveHash, depth);
+
+        const uint64_t nodesBefore = nodes;
+
+        SaveState saveState = makeMove<team>(move);
+        int score = searchMove<team>(depth, alpha, beta, moveCount == 1, 0);
+        unmakeMove<team>(move, saveState);
+
+        if (searchingMoves != nullptr) searchingMoves->finish(moveHash, depth);
 
         if (timeOut) return { bestMove, alpha };
 
-        if (score >= beta) return { move, beta };
+        rootMove.score = (score > alpha) ? score : -INT_MAX; //Ohne Verbesserung ist score nur die Schranke alpha, die im Lauf der Iteration steigt
+        rootMove.nodes = nodes - nodesBefore;
+
+        if (score >= beta) {
+            transpositionTable->put({ BETA, gameState->hash, depth, beta, move, gameState->turn });
+            return { move, beta };
+        }
 
         if (score > alpha) {
+            type = EXACT;
             alpha = score;
             bestMove = move;
+            updatePv(0, move);
         }
     }
 
+    transpositionTable->put({ type, gameState->hash, depth, alpha, bestMove, gameState->turn });
+
     return { bestMove, alpha };
 }
 
+template<Team team>
+void AlphaBeta::initRootMoves() {
+    MoveList moves;
+    gameState->getPossibleMoves<team>(moves);
+
+    const Transposition root = transpositionTable->get(gameState->hash);
+
+    rootMoves.size = moves.size;
+
+    for (int i = 0; i < moves.size; ++i) {
+        RootMove& rootMove = rootMoves.moves[i];
+        rootMove.move = moves[i];
+        rootMove.nodes = 0;
+
+        //Die vorige Suche oder das Pondering hat die Stellungen nach den Wurzelzgen meist schon bewertet
+        SaveState saveState = makeMove<team>(rootMove.move);
+        const Transposition child = transpositionTable->get(gameState->hash);
+        unmakeMove<team>(rootMove.move, saveState);
+
+        rootMove.score = (child.type == EMPTY) ? -INT_MAX : -child.score;
+    }
+
+    rootMoves.sort((root.type != EMPTY) ? root.move : Move{});
+}
+
+RootMove* RootMoveList::find(const Move& move) {
+    for (int i = 0; i < size; ++i) {
+        if (moves[i].move == move) return &moves[i];
+    }
+
+    return nullptr;
+}
+
+void RootMoveList::sort(const Move& best) {
+    std::stable_sort(moves, moves + size, [&best](const RootMove& a, const RootMove& b) {
+        if ((a.move == best) != (b.move == best)) return a.move == best;
+        if (a.nodes != b.nodes) return a.nodes > b.nodes;
+        return a.score > b.score;
+    });
+}
+
 Move AlphaBeta::iterativeDeepening(const Time start) {
-    this->start = start;
+    assert(threadIndex == 0);
+    assert(!ponderThread.joinable());
+
+    stopSignal = false;
+    searchedNodes = 0;
+
+    return search(start, false);
+}
+
+void AlphaBeta::startPondering() {
+    assert(threadIndex == 0);
+    assert(!ponderThread.joinable());
+
+    if (rootState.isOver()) return;
+
+    stopSignal = false; //Vor dem Start des Threads, damit ein sofortiges stopPondering nicht verloren geht
+    searchedNodes = 0;
+    ponderThread = std::thread([this] { ponderMove = search(std::chrono::steady_clock::now(), true); });
+}
+
+Move AlphaBeta::stopPondering() {
+    if (!ponderThread.joinable()) return Move{};
+
+    stopSignal = true;
+    ponderThread.join();
+
+    return ponderMove;
+}
+
+Move AlphaBeta::search(const Time start, const bool ponder) {
     timeOut = false;
+    nodes = 0;
+    polledNodes = 0;
+    SEARCH_STAT(stats = SearchStats{});
+
+#ifdef COPY_MAKE
+    positions[0] = rootState;
+    gameState = positions;
+#else
+    searchState = rootState;
+    gameState = &searchState;
+#endif
+
+    rootTurn = gameState->turn;
+
+    assert(config.aspirationWindow == 0 || config.aspirationGrowth > 1);
+
+    //Werte aus frheren Zgen sollen neue Ergebnisse nicht berdecken. Nur einmal pro Zug, die History
+    //des Ponderings soll in die folgende Suche eingehen.
+    if (!ponder) history.age(config.historyAging);
+
+    for (int ply = 0; ply < MAX_PLY; ++ply) {
+        killers[ply][0] = killers[ply][1] = Move{};
+        moveStack[ply] = Move{};
+    }
+
+    pvSize = 0; //Die Hauptvariante des vorigen Zugs beginnt in einer anderen Stellung
+
+    if (gameState->turn % 2 == ONE) initRootMoves<ONE>();
+    else initRootMoves<TWO>();
+
+    std::vector<std::thread> threads;
+
+    if (threadIndex == 0) {
+        timeManager->startSearch(start, rootState, ponder);
+        if (!ponder) stopTimer.start(timeManager->hardDeadline(), stopSignal);
+        for (const std::unique_ptr<AlphaBeta>& helper : helpers) threads.emplace_back(&AlphaBeta::search, helper.get(), start, ponder);
+    }
 
     Move bestMove;
+    int score = 0; //Bewertung der letzten vollstndigen Iteration
+
+    const int firstDepth = (config.parallelMode == LAZY_SMP) ? 1 + threadIndex % 2 : 1; //Bei ABDADA teilen sich alle Threads eine Tiefe
+
+    for (int depth = firstDepth; depth <= config.maxDepth; ++depth) {
+        int delta = config.aspirationWindow;
+        int alpha = -INT_MAX;
+        int beta = INT_MAX;
+
+        if (bestMove != Move{} && delta > 0) { //Die Bewertung ndert sich zwischen zwei Iterationen meist nur wenig
+            alpha = score - delta;
+            beta = score + delta;
+        }
+
+        MoveValuePair moveValuePair;
+
+        while (true) {
+            moveValuePair = (gameState->turn % 2 == ONE)
+                ? alphaBetaRoot<ONE>(depth, alpha, beta)
+                : alphaBetaRoot<TWO>(depth, alpha, beta);
+
+            if (!timeOut) rootMoves.sort(moveValuePair.move); //Auch nach einem Fail-Low oder Fail-High fr die Wiederholung
+
+            if (timeOut) break;
 
-    for (int depth = 1; depth <= 20; ++depth) {
-        MoveValuePair moveValuePair = alphaBetaRoot(depth, -INT_MAX, INT_MAX);
+            //Fail-Low oder Fail-High: nur die berschrittene Grenze wird erweitert, ab WINNING_SCORE ganz geffnet
+            if (moveValuePair.value <= alpha) {
+                delta *= config.aspirationGrowth;
+                alpha = (delta >= WINNING_SCORE) ? -INT_MAX : score - delta;
+            }
+            else if (moveValuePair.value >= beta) {
+                delta *= config.aspirationGrowth;
+                beta = (delta >= WINNING_SCORE) ? INT_MAX : score + delta;
+            }
+            else break;
+        }
 
-        if (timeOut && depth > 1) break;
+        if (timeOut && bestMove != Move{}) break;
 
         bestMove = moveValuePair.move;
+        score = moveValuePair.value;
+
+        pvSize = pvLength[0];
+        for (int i = 0; i < pvSize; ++i) pv[i] = pvTable[0][i];
+
+        assert(timeOut || pvSize == 0 || pv[0] == bestMove);
 
-        printf("DEBUG: d=%i s=%i\n", depth, moveValuePair.value);
+        if (threadIndex == 0) {
+            printf(ponder ? "DEBUG: ponder d=%i s=%i pv" : "DEBUG: d=%i s=%i pv", depth, moveValuePair.value);
+            printPv();
+            printf("\n");
+        }
 
         if (timeOut) break;
+
+#ifdef SEARCH_STATS
+        if (threadIndex == 0) {
+            stats.depth = depth;
+            stats.iterationNodes[depth] = nodes;
+            stats.iterationQNodes[depth] = stats.qnodes;
+            stats.iterationTime[depth] = timeManager->elapsed();
+        }
+#endif
+
+        if (threadIndex == 0 && !timeManager->nextIteration(depth, bestMove, score)) break; //Die Helfer suchen, bis der Hauptthread fertig ist
+    }
+
+    if (threadIndex == 0) {
+        stopTimer.cancel();
+        stopSignal = true;
+        for (std::thread& thread : threads) thread.join();
+
+        timeManager->stopSearch();
+
+#ifdef SEARCH_STATS
+        for (const std::unique_ptr<AlphaBeta>& helper : helpers) stats.add(helper->stats);
+        stats.print(ponder, getNodes(), timeManager->elapsed());
+#endif
     }
 
-    assert(bestMove != Move{});
+    assert(bestMove != Move{} || threadIndex != 0 || ponder); //Helfer und Pondering knnen vor der ersten Iteration gestoppt werden
 
     return bestMove;
 }
\ No newline at end of file
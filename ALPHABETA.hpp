@@ -1,32 +1,221 @@
 #pragma once
 #include "DEFINITION.hpp"
 #include "GAMESTATE.hpp"
+#include "MOVEPICKER.hpp"
+#include "TIMEMANAGER.hpp"
 #include "TRANSPOSITIONTABLE.hpp"
+#include <algorithm>
+#include <atomic>
+#include <memory>
 #include <stdint.h>
+#include <thread>
+#include <vector>
 
-struct MoveValuePair {
+#define MAX_PLY 64 //Maximale Suchtiefe in Halbzgen ab der Wurzel (TURN_LIMIT begrenzt die Partie auf 60)
+#define LMR_MIN_DEPTH 3 //Erst ab dieser Resttiefe werden spte Zge reduziert
+#define LMR_MIN_MOVES 3 //So viele Zge eines Knotens werden immer mit voller Tiefe gesucht
+#define NULL_MOVE_MIN_DEPTH 3 //Erst ab dieser Resttiefe wird ein Null Move versucht
+
+#ifdef SEARCH_STATS
+#define CUTOFF_INDEX_COUNT 8 //Beta-Cutoffs werden nach der Nummer des Zugs gezhlt, der letzte Eintrag sammelt alle spteren Zge
+
+/*Zhler fr die Abstimmung der Suche, nur mit SEARCH_STATS (Prprozessor-Definition) bersetzt.
+Jeder Thread zhlt fr sich, der Hauptthread addiert am Ende die Zhler der Helfer und gibt pro Zug eine Zeile STATS aus.
+Knoten und Zeit pro Iteration werden nur im Hauptthread mitgeschrieben, jeweils als Stand am Ende der Iteration.*/
+struct SearchStats {
+    uint64_t qnodes = 0; //Knoten in quiesce, in AlphaBeta::nodes enthalten
+    uint64_t ttProbes = 0;
+    uint64_t ttHits = 0; //Eintrag zur Stellung gefunden
+    uint64_t ttCutoffs = 0; //Knoten, die ohne Suche mit dem Wert aus der Tabelle verlassen wurden
+    uint64_t nullMoveCutoffs = 0;
+    uint64_t cutoffs[CUTOFF_INDEX_COUNT]{}; //Beta-Cutoffs in alphaBeta nach Zugnummer (0 fr den ersten Zug)
+    int depth = 0; //Letzte vollstndige Iteration des Hauptthreads
+    uint64_t iterationNodes[MAX_PLY + 1]{};
+    uint64_t iterationQNodes[MAX_PLY + 1]{};
+    int iterationTime[MAX_PLY + 1]{}; //Millisekunden ab start
+
+    void addCutoff(const int moveCount) {
+        ++cutoffs[std::min(moveCount, CUTOFF_INDEX_COUNT) - 1];
+    }
+
+    void add(const SearchStats& other); //Addiert die Zhler eines Helfers, ohne die Iterationen
+
+    void print(const bool ponder, const uint64_t nodes, const int time) const; //Gibt alle Werte in einer Zeile aus, nodes und time fr die ganze Suche
+};
+
+#define SEARCH_STAT(statement) statement
+#else
+#define SEARCH_STAT(statement)
+#endif
+
+struct RootMove { //Zug an der Wurzel mit den Ergebnissen seiner letzten Suche
     Move move;
-    int value;
+    int score; //Aus Sicht der Wurzel, -INT_MAX fr Zge, die alpha nicht verbessert haben oder unbekannt sind
+    uint64_t nodes; //Gre des Teilbaums
+};
+
+/*Die Wurzelzge bleiben ber alle Iterationen einer Suche erhalten und werden nach jeder Suche an der Wurzel umsortiert:
+der beste Zug zuerst, dann nach nodes und bei gleichem nodes nach score.
+Ein groer Teilbaum heit, dass der Zug schwer zu widerlegen war und eher der nchste beste Zug wird.
+Zu Beginn einer Suche ist nodes 0, dann entscheiden der Zug und die Bewertungen aus der Transpositionstabelle,
+die die vorige Suche und das Pondering hinterlassen haben.*/
+struct RootMoveList {
+    RootMove moves[MAX_MOVES];
+    int size = 0;
+
+    RootMove* find(const Move& move);
+
+    void sort(const Move& best); //Stabil, best zuerst
+};
+
+enum ParallelMode { //Verfahren, nach dem sich mehrere Threads die Suche teilen
+    LAZY_SMP, //Alle Threads suchen unabhngig, nur die Transpositionstabelle wird geteilt
+    ABDADA //Zustzlich stellen die Threads Zge zurck, die gerade ein anderer Thread durchsucht
+};
+
+/*Schalter und Grenzen der Suche. Im Spiel werden die Standardwerte verwendet,
+Benchmark::search vergleicht damit die Knotenzahlen mit und ohne ein Verfahren bei fester Tiefe.*/
+struct SearchConfig {
+    int maxDepth = 20; //Hchste Tiefe der iterativen Vertiefung, begrenzt die Suche wie nodeLimit auch ohne Zeitgrenze
+    int timeLimit = 1950; //Bedenkzeit pro Zug in Millisekunden abzglich einer festen Reserve, daraus berechnet der TimeManager die Grenzen
+    bool pvs = true; //Principal Variation Search: nur der erste Zug eines Knotens bekommt das volle Fenster
+    int aspirationWindow = 10; //Abstand der Fenstergrenzen zur Bewertung der vorigen Iteration, 0 schaltet Aspiration Windows ab
+    int aspirationGrowth = 4; //Faktor, um den der Abstand nach einem Fail-Low oder Fail-High auf dieser Seite wchst
+    bool lmr = true; //Late Move Reductions: spte ruhige Zge zuerst mit geringerer Tiefe suchen
+    double lmrBase = 0.75; //Reduktion = lmrBase + ln(Tiefe) * ln(Zugnummer) / lmrDivisor
+    double lmrDivisor = 2.25;
+    bool nullMove = true; //Null Move Pruning: Abschneiden, wenn selbst ein ausgelassener Zug noch beta erreicht
+    int nullMoveReduction = 2; //Um so viel wird die Suche nach dem Null Move zustzlich verkrzt
+    bool butterflyHistory = false; //History nach Start- und Zielfeld statt nach PieceType und Zielfeld
+    int historyAging = 2; //Vor jeder Suche werden alle Historywerte durch diesen Wert geteilt, 1 schaltet das ab
+    bool counterMoves = false; //Konterzug auf den vorigen Zug nach den Killerzgen sortieren, kostet in Benchmark::search bisher Knoten
+    bool nullMoveVerification = false; //Besttigt einen Cutoff durch eine reduzierte Suche ohne Null Move
+    bool ponder = true; //Whrend der Gegner am Zug ist, dessen Stellung weiter durchsuchen und so die Transpositionstabelle fllen
+    int stopPollNodes = 256; //Nach so vielen Knoten fragt ein Thread das Stop-Flag ab und meldet seine Knoten fr nodeLimit
+    uint64_t nodeLimit = 0; //Die Suche endet nach so vielen Knoten aller Threads (auch beim Pondering), 0 fr keine Grenze
+    int threads = 1; //Anzahl der Threads, die gleichzeitig suchen (der aufrufende und threads - 1 Helfer)
+    ParallelMode parallelMode = LAZY_SMP; //Nur bei threads > 1 von Bedeutung
 };
 
+/*Mit COPY_MAKE (Prprozessor-Definition) wird jeder Zug auf einer Kopie der Stellung ausgefhrt:
+makeMove kopiert die 64 Byte groe Stellung in den nchsten Eintrag von positions, unmakeMove geht nur einen Eintrag zurck.
+Ohne COPY_MAKE wird wie bisher auf einer Stellung mit makeMove/unmakeMove gearbeitet (vergleiche Benchmark::copyMake).
+
+Pondering: Nach dem eigenen Zug durchsucht das AlphaBeta mit allen Threads die Stellung, in der der Gegner am Zug ist,
+bis dessen Zug eintrifft. Die Suche deckt alle Antworten des Gegners ab. Hat sie den richtigen Zug vorhergesagt,
+findet die nchste Suche die Stellung und die Teilbume darunter bereits in der Transpositionstabelle und
+erreicht in derselben Zeit eine grere Tiefe.
+
+Lazy SMP: Mit config.threads > 1 legt das AlphaBeta Helfer an, die in eigenen Threads dieselbe Wurzel durchsuchen.
+Jeder Helfer hat eigene Kopien von Stellung, History und Killern, nur die Transpositionstabelle wird geteilt.
+Helfer mit ungeradem Index beginnen eine Tiefe weiter, so verteilen sich die Threads auf zwei Tiefen und fllen
+die Tabelle fr den Hauptthread. Ist der Hauptthread fertig, beendet er ber stop alle Helfer und gibt seinen Zug zurck.
+
+ABDADA: Alle Threads suchen dieselbe Tiefe. Der erste Zug eines Knotens wird immer sofort gesucht (Young Brothers Wait),
+jeder weitere Zug, den laut searchingMoves gerade ein anderer Thread durchsucht, wird zurckgestellt und erst nach den brigen
+Zgen gesucht. So verteilen sich die Geschwister eines Knotens ohne Aufteilungspunkte auf die Threads, und die
+zurckgestellten Ergebnisse stehen meist schon in der Transpositionstabelle, wenn der Thread zu ihnen zurckkehrt.*/
 class AlphaBeta {
 private:
-    GameState& gameState;
-    TranspositionTable transpositionTable{};
-    uint64_t history[PIECE_TYPE_COUNT][FIELD_COUNT]{};
-    Time start;
+    const SearchConfig config;
+    GameState& rootState; //Stellung an der Wurzel, gehrt dem Aufrufer
+    GameState* gameState = nullptr; //Aktuell durchsuchte Stellung
+#ifdef COPY_MAKE
+    GameState positions[MAX_PLY + 1]; //Eine Stellung pro Ply ab der Wurzel
+#else
+    GameState searchState; //Kopie von rootState, auf der makeMove/unmakeMove arbeiten
+#endif
+    std::unique_ptr<TranspositionTable> ownTranspositionTable; //Die own-Zeiger sind nur im Haupt-AlphaBeta gesetzt, Helfer verwenden die Zeiger darunter
+    std::unique_ptr<TimeManager> ownTimeManager;
+    std::unique_ptr<SearchingMoves> ownSearchingMoves;
+    TranspositionTable* transpositionTable; //Bei Lazy SMP von allen Threads geteilt
+    TimeManager* timeManager; //Nur der Hauptthread verwendet den TimeManager, die Helfer fragen nur das Stop-Flag ab
+    SearchingMoves* searchingMoves = nullptr; //Nur bei ABDADA mit mehreren Threads
+    std::atomic<bool> stopSignal{ false };
+    std::atomic<bool>* stop; //Wird vom StopTimer, bei Erreichen von nodeLimit oder vom fertigen Hauptthread gesetzt, alle Threads fragen es ab
+    std::atomic<uint64_t> searchedNodes{ 0 };
+    std::atomic<uint64_t>* sharedNodes; //Knoten aller Threads fr nodeLimit, in Schritten von stopPollNodes gezhlt
+    StopTimer stopTimer; //Nur im Haupt-AlphaBeta
+    std::vector<std::unique_ptr<AlphaBeta>> helpers; //Nur im Haupt-AlphaBeta
+    std::thread ponderThread; //Sucht zwischen startPondering und stopPondering die Stellung mit dem Gegner am Zug
+    Move ponderMove; //Erwarteter Zug des Gegners, Ergebnis der letzten Ponder-Suche
+    const int threadIndex = 0; //0 fr den Hauptthread
+    History history{};
+    Move killers[MAX_PLY][KILLER_COUNT]{}; //Ruhige Zge, die auf derselben Ply zuletzt einen Beta-Cutoff ausgelst haben
+    Move counterMoves[FIELD_COUNT][FIELD_COUNT]{}; //Ruhiger Zug, der zuletzt auf einen Zug (Start- und Zielfeld) einen Beta-Cutoff ausgelst hat
+    RootMoveList rootMoves;
+    Move moveStack[MAX_PLY]{}; //Der auf jeder Ply gerade gesuchte Zug, Move{} fr einen Null Move
+    Move pvTable[MAX_PLY + 1][MAX_PLY + 1]{}; //Dreieckstabelle: pvTable[ply] enthlt ab Index ply die beste Fortsetzung des Knotens auf ply
+    int pvLength[MAX_PLY + 1]{}; //Ende der Fortsetzung in pvTable[ply]
+    Move pv[MAX_PLY + 1]{}; //Hauptvariante der letzten vollstndigen Iteration
+    int pvSize = 0;
+    bool pvNode[MAX_PLY + 1]{}; //Folgen alle Zge bis zu dieser Ply der Hauptvariante?
+    int rootTurn = 0;
+    uint64_t nodes = 0; //Besuchte Knoten der letzten Suche (alphaBeta und quiesce)
+    uint64_t polledNodes = 0; //Stand von nodes bei der letzten Abfrage des Stop-Flags
+#ifdef SEARCH_STATS
+    SearchStats stats;
+#endif
+    int reductions[MAX_PLY][MAX_MOVES]{}; //Late Move Reductions nach Resttiefe und Zugnummer, im Konstruktor aus config berechnet
     bool timeOut;
 
-    bool checkTimeOut();
+    AlphaBeta(GameState& gameState, const SearchConfig& config, AlphaBeta& main, const int threadIndex); //Helfer fr Lazy SMP und ABDADA
+
+    bool checkTimeOut(); //Fragt alle stopPollNodes Knoten das Stop-Flag ab, die Uhr liest nur der StopTimer
 
+    //team ist jeweils das Team am Zug, es wird nur in iterativeDeepening nach turn % 2 verzweigt
+
+    template<Team team>
+    SaveState makeMove(const Move& move); //Fhrt den Zug auf gameState aus (bei COPY_MAKE auf einer Kopie)
+
+    template<Team team>
+    void unmakeMove(const Move& move, const SaveState& saveState);
+
+    void makeNullMove();
+
+    void unmakeNullMove();
+
+    bool isNullMoveAllowed(const int depth, const int alpha, const int beta) const; //Prft, ob ein Null Move in gameState sinnvoll und fr Ostseeschach unbedenklich ist
+
+    template<Team team>
     int quiesce(int alpha, int beta);
 
-    int alphaBeta(const int depth, int alpha, int beta);
+    template<Team team>
+    int alphaBeta(const int depth, int alpha, int beta, const bool allowNullMove = true);
+
+    void updatePv(const int ply, const Move& move); //Neuer bester Zug auf ply, bernimmt die Fortsetzung des Kindknotens
+
+    void printPv() const;
+
+    bool deferMove(const Move& move, const int depth, const int moveCount, Move* deferred, int& deferredCount) const; //ABDADA: stellt den Zug zurck, wenn ein anderer Thread ihn gerade sucht
+
+    template<Team team>
+    int searchMove(const int depth, const int alpha, const int beta, const bool first, const int reduction); //Sucht den Knoten nach einem Zug, mit PVS und LMR bei Bedarf mehrmals
 
-    MoveValuePair alphaBetaRoot(const int depth, int alpha, int beta);
+    Move search(const Time start, const bool ponder); //Iterative Vertiefung ab rootState, ponder sucht ohne Zeitgrenze bis stop gesetzt wird
+
+    template<Team team>
+    void initRootMoves(); //Erzeugt die Wurzelzge und sortiert sie nach den Eintrgen der Transpositionstabelle
+
+    template<Team team>
+    MoveValuePair alphaBetaRoot(const int depth, int alpha, int beta); //Sucht die Wurzelzge in der Reihenfolge von rootMoves
 
 public:
-    AlphaBeta(GameState& gameState);
+    AlphaBeta(GameState& gameState, const SearchConfig& config = SearchConfig{});
+
+    AlphaBeta(const AlphaBeta&) = delete;
+
+    AlphaBeta& operator=(const AlphaBeta&) = delete;
+
+    ~AlphaBeta();
 
     Move iterativeDeepening(const Time start);
+
+    void startPondering(); //Sucht im Hintergrund weiter, bis stopPondering aufgerufen wird, rootState darf bis dahin nicht verndert werden
+
+    Move stopPondering(); //Beendet die Ponder-Suche und gibt den erwarteten Zug des Gegners zurck, Move{} wenn nicht gesucht wurde
+
+    void recordSend(const Time sent); //Meldet dem TimeManager, wann der gefundene Zug gesendet wurde
+
+    uint64_t getNodes() const; //Besuchte Knoten der letzten Suche, einschlielich der Helfer
 };
\ No newline at end of file
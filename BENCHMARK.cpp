@@ -0,0 +1,245 @@
+#include "ALPHABETA.hpp"
+#include "BENCHMARK.hpp"
+#include "DEFINITION.hpp"
+#include "GAMESTATE.hpp"
+#include <assert.h>
+#include <chrono>
+#include <limits.h>
+#include <stdio.h>
+
+typedef std::chrono::microseconds US;
+
+#define BENCHMARK_POSITION_COUNT 3
+
+const char* benchmarkPositions[BENCHMARK_POSITION_COUNT]{
+    "H......r/M......s/S......m/R......h/R......h/S......m/M......s/H......r", //Startaufstellung
+    "R......m/H......h/S......s/M......r/M......r/S......s/H......h/R......m", //Startaufstellung
+    "..H..r../M...s.../..S.Rm../.R...h../...h..../S.M..m../...s..r./H.....R." //Mittelspiel
+};
+
+void Benchmark::loadPosition(const char* position, GameState& gameState) {
+    gameState = GameState{};
+
+    int y = 0;
+    int x = 0;
+
+    for (const char* c = position; *c != '\0'; ++c) {
+        if (*c == '/') {
+            assert(x == 8);
+            ++y;
+            x = 0;
+            continue;
+        }
+
+        assert(x < 8 && y < 8);
+
+        Position pos;
+        pos.coords.x = x++;
+        pos.coords.y = y;
+
+        if (*c == '.') continue;
+
+        Field field{};
+        field.occupied = true;
+        field.team = (*c >= 'a') ? TWO : ONE;
+        field.stacked = false;
+
+        switch (*c) {
+        case 'H': case 'h': field.pieceType = HERZMUSCHEL; break;
+        case 'M': case 'm': field.pieceType = MOEWE; break;
+        case 'S': case 's': field.pieceType = SEESTERN; break;
+        default: assert(*c == 'R' || *c == 'r'); field.pieceType = ROBBE; break;
+        }
+
+        gameState.setField(pos.square, field);
+    }
+}
+
+void Benchmark::perft(const int depth) {
+    uint64_t totalNodes = 0;
+    long long totalUs = 0;
+
+    for (int position = 0; position < BENCHMARK_POSITION_COUNT; ++position) {
+        GameState gameState{};
+        loadPosition(benchmarkPositions[position], gameState);
+
+        for (int d = 1; d <= depth; ++d) {
+            const auto start = std::chrono::steady_clock::now();
+            const uint64_t nodes = gameState.perft(d);
+            const long long us = std::chrono::duration_cast<US>(std::chrono::steady_clock::now() - start).count();
+
+            printf("PERFT: position=%i depth=%i nodes=%llu time=%llims nps=%llu\n",
+                position, d, (unsigned long long)nodes, us / 1000,
+                (unsigned long long)(nodes * 1000000 / (us > 0 ? us : 1)));
+
+            if (d == depth) {
+                totalNodes += nodes;
+                totalUs += us;
+            }
+        }
+    }
+
+    printf("PERFT: total nodes=%llu time=%llims nps=%llu\n",
+        (unsigned long long)totalNodes, totalUs / 1000,
+        (unsigned long long)(totalNodes * 1000000 / (totalUs > 0 ? totalUs : 1)));
+}
+
+void Benchmark::divide(const int depth, const int position) {
+    assert(position >= 0 && position < BENCHMARK_POSITION_COUNT);
+
+    GameState gameState{};
+    loadPosition(benchmarkPositions[position], gameState);
+
+    gameState.divide(depth);
+}
+
+
+uint64_t perftCopyMake(const GameState& gameState, const int depth) { //Wie GameState::perft, aber jeder Zug wird auf einer Kopie ausgefhrt
+    assert(depth > 0);
+
+    if (gameState.isOver()) return 1;
+
+    MoveList moves;
+    gameState.getPossibleMoves(moves);
+
+    if (depth == 1) return moves.size;
+
+    uint64_t nodes = 0;
+
+    for (const MoveValuePair& entry : moves) {
+        GameState child = gameState;
+        child.makeMove(entry.move);
+        nodes += perftCopyMake(child, depth - 1);
+    }
+
+    return nodes;
+}
+
+void Benchmark::copyMake(const int depth) {
+    long long totalUs[2]{};
+
+    for (int position = 0; position < BENCHMARK_POSITION_COUNT; ++position) {
+        GameState gameState{};
+        loadPosition(benchmarkPositions[position], gameState);
+
+        auto start = std::chrono::steady_clock::now();
+        const uint64_t makeNodes = gameState.perft(depth);
+        const long long makeUs = std::chrono::duration_cast<US>(std::chrono::steady_clock::now() - start).count();
+
+        start = std::chrono::steady_clock::now();
+        const uint64_t copyNodes = perftCopyMake(gameState, depth);
+        const long long copyUs = std::chrono::duration_cast<US>(std::chrono::steady_clock::now() - start).count();
+
+        if (makeNodes != copyNodes) { //Auch ohne assert (Release) sichtbar
+            printf("COPYMAKE: position=%i depth=%i mismatch make/unmake=%llu copy=%llu\n",
+                position, depth, (unsigned long long)makeNodes, (unsigned long long)copyNodes);
+        }
+
+        printf("COPYMAKE: position=%i depth=%i nodes=%llu make/unmake=%llims copy=%llims\n",
+            position, depth, (unsigned long long)makeNodes, makeUs / 1000, copyUs / 1000);
+
+        totalUs[0] += makeUs;
+        totalUs[1] += copyUs;
+    }
+
+    printf("COPYMAKE: sizeof(GameState)=%i make/unmake=%llims copy=%llims\n",
+        (int)sizeof(GameState), totalUs[0] / 1000, totalUs[1] / 1000);
+}
+
+uint64_t Benchmark::search(const int depth, const SearchConfig& config) {
+    uint64_t totalNodes = 0;
+
+    for (int position = 0; position < BENCHMARK_POSITION_COUNT; ++position) {
+        GameState gameState{};
+        loadPosition(benchmarkPositions[position], gameState);
+
+        AlphaBeta alphaBeta{ gameState, config };
+
+        const auto start = std::chrono::steady_clock::now();
+        const Move move = alphaBeta.iterativeDeepening(std::chrono::steady_clock::now());
+        const long long us = std::chrono::duration_cast<US>(std::chrono::steady_clock::now() - start).count();
+
+        printf("SEARCH: position=%i depth=%i move=(%i, %i) -> (%i, %i) nodes=%llu time=%llims\n",
+            position, depth, move.from().coords.x, move.from().coords.y, move.to().coords.x, move.to().coords.y,
+            (unsigned long long)alphaBeta.getNodes(), us / 1000);
+
+        totalNodes += alphaBeta.getNodes();
+    }
+
+    return totalNodes;
+}
+
+void printComparison(const char* name, const int depth, const SearchConfig& config, const uint64_t allNodes, const long long allUs) { //Vergleicht eine Konfiguration mit der Standardkonfiguration
+    const auto start = std::chrono::steady_clock::now();
+    const uint64_t nodes = Benchmark::search(depth, config);
+    const long long us = std::chrono::duration_cast<US>(std::chrono::steady_clock::now() - start).count();
+
+    printf("SEARCH: %s nodes=%llu (%+.1f%%) time=%llims (%+.1f%%)\n",
+        name, (unsigned long long)nodes, allNodes > 0 ? 100.0 * ((double)nodes - (double)allNodes) / (double)allNodes : 0.0,
+        us / 1000, allUs > 0 ? 100.0 * (double)(us - allUs) / (double)allUs : 0.0);
+}
+
+void Benchmark::search(const int depth) {
+    SearchConfig config{};
+    config.maxDepth = depth;
+    config.timeLimit = INT_MAX; //Feste Tiefe, damit die Knotenzahlen vergleichbar sind
+
+    const auto start = std::chrono::steady_clock::now();
+    const uint64_t allNodes = search(depth, config);
+    const long long allUs = std::chrono::duration_cast<US>(std::chrono::steady_clock::now() - start).count();
+
+    printf("SEARCH: depth=%i nodes=%llu time=%llims\n", depth, (unsigned long long)allNodes, allUs / 1000);
+
+    SearchConfig variant = config;
+    variant.pvs = false;
+    printComparison("without pvs", depth, variant, allNodes, allUs);
+
+    variant = config;
+    variant.aspirationWindow = 0;
+    printComparison("without aspiration", depth, variant, allNodes, allUs);
+
+    variant = config;
+    variant.lmr = false;
+    printComparison("without lmr", depth, variant, allNodes, allUs);
+
+    variant = config;
+    variant.butterflyHistory = true;
+    printComparison("with butterfly history", depth, variant, allNodes, allUs);
+
+    variant = config;
+    variant.counterMoves = true;
+    printComparison("with counter moves", depth, variant, allNodes, allUs);
+
+    variant = config;
+    variant.nullMove = false;
+    printComparison("without null move", depth, variant, allNodes, allUs);
+
+    variant = config;
+    variant.nullMoveVerification = true;
+    printComparison("with null move verification", depth, variant, allNodes, allUs);
+}
+
+void Benchmark::smp(const int depth) {
+    long long singleUs = 0;
+
+    for (const ParallelMode mode : { LAZY_SMP, ABDADA }) {
+        for (int threads = 1; threads <= 16; threads *= 2) {
+            if (mode == ABDADA && threads == 1) continue; //Mit einem Thread sind beide Verfahren gleich
+
+            SearchConfig config{};
+            config.maxDepth = depth;
+            config.timeLimit = INT_MAX;
+            config.threads = threads;
+            config.parallelMode = mode;
+
+            const auto start = std::chrono::steady_clock::now();
+            const uint64_t nodes = search(depth, config);
+            const long long us = std::chrono::duration_cast<US>(std::chrono::steady_clock::now() - start).count();
+
+            if (threads == 1) singleUs = us;
+
+            printf("SMP: mode=%s threads=%i depth=%i nodes=%llu time=%llims speedup=%.2f\n", (mode == LAZY_SMP) ? "lazy" : "abdada",
+                threads, depth, (unsigned long long)nodes, us / 1000, (double)singleUs / (double)(us > 0 ? us : 1));
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,24 @@
+#pragma once
+#include "DEFINITION.hpp"
+#include "ALPHABETA.hpp"
+#include "GAMESTATE.hpp"
+
+/*Feste Stellungen und Messungen, die ohne Server laufen (Aufruf ber die Kommandozeile, siehe main).
+Eine Stellung wird als 8 Zeilen (y = 0 bis 7) getrennt durch '/' angegeben, jede Zeile enthlt die Felder x = 0 bis 7.
+Grobuchstaben sind Spielsteine von Team 1, Kleinbuchstaben von Team 2 (H/M/S/R), '.' ist ein leeres Feld.*/
+class Benchmark {
+public:
+    static void loadPosition(const char* position, GameState& gameState); //Setzt die Spielsteine einer Stellung
+
+    static void perft(const int depth); //Gibt fr alle festen Stellungen Knoten und Knoten pro Sekunde bis zur Tiefe depth aus
+
+    static void divide(const int depth, const int position); //Gibt die Knoten je Wurzelzug einer festen Stellung aus
+
+    static void copyMake(const int depth); //Vergleicht perft mit makeMove/unmakeMove und mit Kopieren der Stellung
+
+    static void search(const int depth); //Sucht alle festen Stellungen bis zur Tiefe depth und vergleicht die Knotenzahlen der Suchverfahren
+
+    static uint64_t search(const int depth, const SearchConfig& config); //Summe der Knoten ber alle festen Stellungen mit einer Konfiguration
+
+    static void smp(const int depth); //Zeit bis zur Tiefe depth mit 1 bis 16 Threads, mit Lazy SMP und mit ABDADA
+};
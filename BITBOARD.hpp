@@ -0,0 +1,60 @@
+#pragma once
+#include <stdint.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+/*Ein Bitboard speichert fr jedes der 64 Spielfelder ein Bit. Das Bit mit dem Index Position::square
+gehrt zu dem jeweiligen Feld. Da square = x * 8 + y ist, liegt jede Spalte x in genau einem Byte.
+Statt alle 64 Felder abzulaufen, werden nur die gesetzten Bits mit popLsb durchlaufen.*/
+typedef uint64_t Bitboard;
+
+inline Bitboard squareBit(const int square) { //Bitboard mit genau einem gesetzten Feld
+    return (Bitboard)1 << square;
+}
+
+inline int popCount(const Bitboard bitboard) { //Anzahl der gesetzten Felder
+#if defined(_MSC_VER) && defined(_M_X64)
+    return (int)__popcnt64(bitboard);
+#elif defined(_MSC_VER)
+    return (int)(__popcnt((uint32_t)bitboard) + __popcnt((uint32_t)(bitboard >> 32)));
+#else
+    return __builtin_popcountll(bitboard);
+#endif
+}
+
+inline int lsb(const Bitboard bitboard) { //Index des niedrigsten gesetzten Feldes, bitboard darf nicht leer sein
+#if defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index;
+    _BitScanForward64(&index, bitboard);
+    return (int)index;
+#elif defined(_MSC_VER)
+    unsigned long index;
+    if (_BitScanForward(&index, (uint32_t)bitboard)) return (int)index;
+    _BitScanForward(&index, (uint32_t)(bitboard >> 32));
+    return (int)index + 32;
+#else
+    return __builtin_ctzll(bitboard);
+#endif
+}
+
+inline int msb(const Bitboard bitboard) { //Index des hchsten gesetzten Feldes, bitboard darf nicht leer sein
+#if defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index;
+    _BitScanReverse64(&index, bitboard);
+    return (int)index;
+#elif defined(_MSC_VER)
+    unsigned long index;
+    if (_BitScanReverse(&index, (uint32_t)(bitboard >> 32))) return (int)index + 32;
+    _BitScanReverse(&index, (uint32_t)bitboard);
+    return (int)index;
+#else
+    return 63 - __builtin_clzll(bitboard);
+#endif
+}
+
+inline int popLsb(Bitboard& bitboard) { //Entfernt das niedrigste gesetzte Feld und gibt dessen Index zurck
+    const int square = lsb(bitboard);
+    bitboard &= bitboard - 1;
+    return square;
+}
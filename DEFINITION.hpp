@@ -1,8 +1,9 @@
 #pragma once
+#include <assert.h>
 #include <chrono>
 #include <cstdint>
 
-typedef std::chrono::time_point<std::chrono::system_clock> Time; //Reprsentiert einen bestimmten Zeitpunkt
+typedef std::chrono::time_point<std::chrono::steady_clock> Time; //Reprsentiert einen bestimmten Zeitpunkt (monoton, unabhngig von nderungen der Systemzeit)
 typedef std::chrono::milliseconds MS; //Reprsentiert Zeitspanne in Millisekunden
 
 #define TEAM_COUNT 2 //Konstante die die Anzahl der Teams festlegt (2)
@@ -47,11 +48,53 @@ union Position {
     bool operator!=(const Position& p) const { return !operator==(p); } //Vergleicht zwei Position-Objekte, prft ob die square-Werte ungleich sind
 };
 
-struct Move { //Definiert zwei Positionen (from und to) um einen Zug zu reprsentieren
-    Position from, to;
+enum MoveFlag : uint8_t { //Eigenschaften eines Zugs, werden bei der Zuggenerierung gesetzt
+    CAPTURE = 1, //Zielfeld ist von einem gegnerischen Spielstein besetzt
+    STACKING = 2, //Schlagen ohne Punkt, die beiden Spielsteine bilden einen Stapel
+    SCORING_CAPTURE = 4, //Schlagen mit oder gegen einen Stapel, gibt einen Punkt
+    BASELINE = 8 //Spielstein (auer Robbe) erreicht die gegnerische Grundlinie, gibt einen Punkt
+};
+
+struct Move { //Zug in 16 Bit: Startfeld (Bit 0 bis 5), Zielfeld (Bit 6 bis 11) und MoveFlags (Bit 12 bis 15)
+    uint16_t data;
+
+    Move() { data = 0; } //Leerer Zug, Start- und Zielfeld sind gleich
+    Move(const Position from, const Position to, const uint8_t flags = 0) {
+        data = (uint16_t)(from.square | (to.square << 6) | (flags << 12));
+    }
+
+    Position from() const { return Position(data & 0x3F); }
+    Position to() const { return Position((data >> 6) & 0x3F); }
+    uint8_t flags() const { return (uint8_t)(data >> 12); }
+
+    int points() const { return ((flags() & SCORING_CAPTURE) != 0) + ((flags() & BASELINE) != 0); } //Punkte, die der Zug einbringt
+
+    bool operator==(const Move& m) const { return ((m.data ^ data) & 0xFFF) == 0; } //Zwei Zge mit gleichem Start- und Zielfeld werden als gleich betrachtet,
+    bool operator!=(const Move& m) const { return !operator==(m); } //auch wenn bei einem die Flags fehlen (z.B. Zug vom Server)
+};
+
+struct MoveValuePair { //Zug mit zugehrigem Wert (Bewertung oder Sortierschlssel)
+    Move move;
+    int value;
+};
+
+#define MAX_MOVES 64 //Maximale Anzahl an Zgen: 8 Spielsteine mit je hchstens 8 Zielfeldern (Robbe)
+
+struct MoveList { //Zugliste mit fester Kapazitt, liegt auf dem Stack statt auf dem Heap
+    MoveValuePair moves[MAX_MOVES]; //value wird von der Suche als Sortierschlssel verwendet
+    int size = 0;
+
+    void push(const Move& move) {
+        assert(size < MAX_MOVES);
+        moves[size++] = { move, 0 };
+    }
+
+    MoveValuePair* begin() { return moves; }
+    MoveValuePair* end() { return moves + size; }
+    const MoveValuePair* begin() const { return moves; }
+    const MoveValuePair* end() const { return moves + size; }
 
-    bool operator==(const Move& m) const { return m.from == from && m.to == to; } //Ermglicht einen Vergleich von Zgen. Wenn zwei Zge die gleichen Start- und
-    bool operator!=(const Move& m) const { return !operator==(m); } //Wenn zwei Zge die gleichen Start - und Zielfelder haben weren sie als gleich betrachtet.
+    const Move& operator[](const int index) const { return moves[index].move; }
 };
 
 struct SaveState {
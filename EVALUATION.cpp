@@ -46,32 +46,31 @@ int scoreEvaluation(const GameState& gameState) { //Berechnet die Punktedifferen
     return (gameState.score[ONE] - gameState.score[TWO]) * 2000;
 }
 
-int pieceSquareEvaluation(const int square, const Field& field) { //Bewertet die Position einer Figur basierend auf der pieceSquareTable
-    Position pos{ square };
+int pieceSquareEvaluation(const GameState& gameState) { //Bewertet die Positionen aller Figuren basierend auf der pieceSquareTable
+    int value = 0;
 
-    if (field.team == ONE) {
-        return pieceSquareTable[field.pieceType][pos.square];
-    }
-    else {
-        pos.coords.x = 7 - pos.coords.x;
-        return -pieceSquareTable[field.pieceType][pos.square];
+    for (int piece = 0; piece < PIECE_TYPE_COUNT; ++piece) {
+        Bitboard pieces = gameState.teamBoard[ONE] & gameState.pieceBoard(piece);
+        while (pieces) value += pieceSquareTable[piece][popLsb(pieces)];
+
+        pieces = gameState.teamBoard[TWO] & gameState.pieceBoard(piece);
+        while (pieces) value -= pieceSquareTable[piece][popLsb(pieces) ^ 0x38]; //Spiegelt x (7 - x) fr Team 2
     }
+
+    return value;
 }
 
 int pieceDistanceValue(const GameState& gameState) { //Berechnet den Unterschied in der maximalen horizontalen Entfernung der Figuren auf dem Brett
     int maxDist[TEAM_COUNT]{ 0 };
 
-    for (int square = 0; square < FIELD_COUNT; square++) {
-        const Field& field = gameState.board[square];
+    const Bitboard pieces[TEAM_COUNT]{
+        gameState.teamBoard[ONE] & ~gameState.pieceBoard(ROBBE),
+        gameState.teamBoard[TWO] & ~gameState.pieceBoard(ROBBE)
+    };
 
-        if (!field.occupied) continue;
-        if (field.pieceType == ROBBE) continue;
-
-        const Position pos{ square };
-        const int dist = (field.team == ONE) ? pos.coords.x : (7 - pos.coords.x);
-
-        if (dist > maxDist[field.team]) maxDist[field.team] = dist;
-    }
+    //Jede Spalte x liegt in einem Byte, daher liefert square >> 3 direkt die Spalte
+    if (pieces[ONE]) maxDist[ONE] = msb(pieces[ONE]) >> 3;
+    if (pieces[TWO]) maxDist[TWO] = 7 - (lsb(pieces[TWO]) >> 3);
 
     return maxDist[ONE] - maxDist[TWO];
 }
@@ -92,13 +91,9 @@ int Evaluation::evaluate(const GameState& gameState, const bool isOver) { //Komb
     value += scoreEvaluation(gameState);
     value += pieceDistanceValue(gameState);
 
-    for (int square = 0; square < FIELD_COUNT; ++square) {
-        const Field& field = gameState.board[square];
-        if (!field.occupied) continue;
-
-        value += pieceSquareEvaluation(square, field);
-        if (field.stacked) value += field.team == ONE ? 1 : -1;
-    }
+    value += pieceSquareEvaluation(gameState);
+    value += popCount(gameState.stackedBoard & gameState.teamBoard[ONE]);
+    value -= popCount(gameState.stackedBoard & gameState.teamBoard[TWO]);
 
     if (gameState.turn % 2 == TWO) value = -value;
     return value;
@@ -1,22 +1,59 @@
 #include "DEFINITION.hpp"
 #include "GAMESTATE.hpp"
-#include <algorithm>
+#include "MOVETABLE.hpp"
 #include <cassert>
 #include <ctype.h>
-#include <functional>
+#include <stdio.h>
 #include <string>
-#include <vector>
 
 #define RANDOM_SEED_A 1103515495
 #define RANDOM_SEED_B 12345
 
-GameState::GameState() {
+constexpr PieceMoveTable moveTable[TEAM_COUNT][PIECE_TYPE_COUNT]{ //Zielfelder aller PieceTypes, beim Kompilieren erzeugt
+    {
+        generatePieceMoveTable(ONE, HERZMUSCHEL),
+        generatePieceMoveTable(ONE, MOEWE),
+        generatePieceMoveTable(ONE, SEESTERN),
+        generatePieceMoveTable(ONE, ROBBE)
+    },
+    {
+        generatePieceMoveTable(TWO, HERZMUSCHEL),
+        generatePieceMoveTable(TWO, MOEWE),
+        generatePieceMoveTable(TWO, SEESTERN),
+        generatePieceMoveTable(TWO, ROBBE)
+    }
+};
+
+struct Zobrist { //Speichert Zobrist-Hashes fr verschiedene Aspekte des Spielzustands.
+    uint64_t piece[FIELD_COUNT][TEAM_COUNT][PIECE_TYPE_COUNT];
+    uint64_t stacked[FIELD_COUNT];
+    uint64_t score[TEAM_COUNT][MAX_SCORE];
+    uint64_t turn[TURN_LIMIT + 1]; //makeMove im letzten Zug setzt turn auf TURN_LIMIT
+};
+/*Zobrist-Hashing ist eine Technik, um den Zustand eines Schachbretts effizient zu hashen und Kollisionen zu minimieren.
+* 
+Einzigartigkeit der Hash-Codes:
+Zobrist-Hashing generiert fr jede Schachposition einen fast eindeutigen Index.
+Selbst hnliche Positionen erzeugen unterschiedliche Hash-Codes.
+Dies ist entscheidend fr die Verwendung in Hash-Tabellen wie Transpositionstabellen.
+
+Effiziente Speicherung und Suche:
+Schach-Engines verwenden Hash-Tabellen, um bereits berechnete Positionen zu speichern.
+Zobrist-Hashes ermglichen schnelle und platzsparende Suchvorgnge in diesen Tabellen.
+
+Reproduzierbarkeit:
+Die Verwendung von Zobrist-Hashes ermglicht die Portabilitt von Schachbchern und Datenbanken ber verschiedene Plattformen hinweg.
+Die gleichen Hash-Codes knnen auf unterschiedlichen Maschinen verwendet werden.*/
+
+constexpr Zobrist generateZobrist() { //Fllt die Tabelle mit einem linearen Kongruenzgenerator, beim Kompilieren ausgewertet
+    Zobrist zobrist{};
+
     uint64_t rand = 1;
     for (int square = 0; square < FIELD_COUNT; ++square) {
         for (int team = 0; team < TEAM_COUNT; ++team) {
             for (int piece = 0; piece < PIECE_TYPE_COUNT; ++piece) {
                 rand = rand * RANDOM_SEED_A + RANDOM_SEED_B;
-                zobrist.piece[square][team][piece] = rand; 
+                zobrist.piece[square][team][piece] = rand;
             }
         }
     }
@@ -30,81 +67,234 @@ GameState::GameState() {
             zobrist.score[team][score] = rand;
         }
     }
-    for (int turn = 0; turn < TURN_LIMIT; ++turn) {
+    for (int turn = 0; turn <= TURN_LIMIT; ++turn) {
         rand = rand * RANDOM_SEED_A + RANDOM_SEED_B;
         zobrist.turn[turn] = rand;
     }
+
+    return zobrist;
 }
 
-#define pushMove(to) \
-    if (!board[square + to].occupied || board[square + to].team != team) { \
-        moves.push_back({pos, square + to}); \
+constexpr Zobrist zobrist = generateZobrist(); //Eine Tabelle fr alle GameStates, die Schlssel sind fr jede Stellung gleich
+
+void GameState::toggleField(const int square, const Field& field) {
+    if (!field.occupied) return;
+
+    const Bitboard bit = squareBit(square);
+
+    teamBoard[field.team] ^= bit;
+    if (field.pieceType & 1) typeBoard[0] ^= bit;
+    if (field.pieceType & 2) typeBoard[1] ^= bit;
+    if (field.stacked) stackedBoard ^= bit;
+
+    if (field.pieceType != ROBBE) {
+        const int distance = (field.team == ONE) ? (square >> 3) : (7 - (square >> 3));
+        const uint32_t count = (uint32_t)1 << (4 * distance);
+
+        if (teamBoard[field.team] & bit) distanceCounts[field.team] += count; //Spielstein wurde hinzugefgt
+        else distanceCounts[field.team] -= count;
     }
+}
 
-std::vector<Move> GameState::getPossibleMoves() const { //Generiert eine Liste der mglichen Zge fr den aktuellen Spielzustand
-    std::vector<Move> moves{};
+Field GameState::getField(const int square) const {
+    const Bitboard bit = squareBit(square);
 
-    const int team = turn % 2;
+    Field field{};
+    field.occupied = ((teamBoard[ONE] | teamBoard[TWO]) & bit) != 0;
+    field.team = (teamBoard[TWO] & bit) ? TWO : ONE;
+    field.pieceType = pieceTypeAt(square);
+    field.stacked = (stackedBoard & bit) != 0;
 
-    const Direction forward = (team == ONE) ? RIGHT : LEFT;
-    const uint8_t oppBaseline = (team == ONE) ? 7 : 0;
+    return field;
+}
 
-    for (int square = 0; square < FIELD_COUNT; ++square) {
-        const Field& field = board[square];
-
-        if (!field.occupied) continue;
-        if (field.team != team) continue;
-
-        const Position pos{ square };
-
-        switch (field.pieceType) {
-        case HERZMUSCHEL:
-            assert(pos.coords.x != oppBaseline);
-            if (pos.coords.y < 7) pushMove(forward + DOWN);
-            if (pos.coords.y > 0) pushMove(forward + UP);
-            break;
-        case MOEWE:
-            if (pos.coords.x < 7) pushMove(RIGHT);
-            if (pos.coords.x > 0) pushMove(LEFT);
-            if (pos.coords.y < 7) pushMove(DOWN);
-            if (pos.coords.y > 0) pushMove(UP);
-            break;
-        case SEESTERN:
-            assert(pos.coords.x != oppBaseline);
-            pushMove(forward);
-            if (pos.coords.x < 7) {
-                if (pos.coords.y < 7) pushMove(RIGHT + DOWN);
-                if (pos.coords.y > 0) pushMove(RIGHT + UP);
-            }
-            if (pos.coords.x > 0) {
-                if (pos.coords.y < 7) pushMove(LEFT + DOWN);
-                if (pos.coords.y > 0) pushMove(LEFT + UP);
-            }
-            break;
-        case ROBBE:
-            if (pos.coords.x < 6) {
-                if (pos.coords.y < 7) pushMove(RIGHT + RIGHT + DOWN);
-                if (pos.coords.y > 0) pushMove(RIGHT + RIGHT + UP);
-            }
-            if (pos.coords.x > 1) {
-                if (pos.coords.y < 7) pushMove(LEFT + LEFT + DOWN);
-                if (pos.coords.y > 0) pushMove(LEFT + LEFT + UP);
+void GameState::setField(const int square, const Field& field) {
+    toggleField(square, getField(square));
+    toggleField(square, field);
+}
+
+template<Team team>
+void GameState::getPossibleMoves(MoveList& moves) const { //Generiert eine Liste der mglichen Zge fr den aktuellen Spielzustand
+    assert(turn % 2 == team);
+
+    moves.size = 0;
+
+    const Bitboard own = teamBoard[team];
+
+    assert(!(own & (pieceBoard(HERZMUSCHEL) | pieceBoard(SEESTERN)) & TeamTraits<team>::oppBaseline));
+
+    for (int piece = 0; piece < PIECE_TYPE_COUNT; ++piece) {
+        const PieceMoveTable& table = moveTable[team][piece];
+
+        Bitboard pieces = own & pieceBoard(piece);
+        while (pieces) {
+            const int square = popLsb(pieces);
+
+            Bitboard destinations = table.mask[square] & ~own;
+            while (destinations) {
+                const int to = popLsb(destinations);
+                moves.push({ square, to, calcFlags<team>(square, to, piece) });
             }
-            if (pos.coords.x < 7) {
-                if (pos.coords.y < 6) pushMove(RIGHT + DOWN + DOWN);
-                if (pos.coords.y > 1) pushMove(RIGHT + UP + UP);
+        }
+    }
+}
+
+template<Team team>
+uint8_t GameState::calcFlags(const int from, const int to, const int pieceType) const {
+    const Bitboard toBit = squareBit(to);
+
+    uint8_t flags = 0;
+
+    if (teamBoard[TeamTraits<team>::opp] & toBit) {
+        flags |= CAPTURE;
+        flags |= (stackedBoard & (squareBit(from) | toBit)) ? SCORING_CAPTURE : STACKING;
+    }
+
+    if (pieceType != ROBBE && (TeamTraits<team>::oppBaseline & toBit)) flags |= BASELINE;
+
+    return flags;
+}
+
+Move GameState::annotateMove(const Move& move) const {
+    assert((teamBoard[ONE] | teamBoard[TWO]) & squareBit(move.from().square));
+
+    const int from = move.from().square;
+    const int to = move.to().square;
+    const int pieceType = pieceTypeAt(from);
+
+    return { move.from(), move.to(), (turn % 2 == ONE) ? calcFlags<ONE>(from, to, pieceType) : calcFlags<TWO>(from, to, pieceType) };
+}
+
+template<Team team>
+Bitboard GameState::threatenedHerzmuscheln() const {
+    const Bitboard oppMoewen = teamBoard[TeamTraits<team>::opp] & pieceBoard(MOEWE);
+    const Bitboard herzmuscheln = teamBoard[team] & pieceBoard(HERZMUSCHEL);
+
+    //Das Feld vor einer Herzmuschel liegt eine Spalte (8 Bit) weiter in Spielrichtung
+    return herzmuscheln & TeamTraits<team>::backward(oppMoewen);
+}
+
+template<Team team>
+void GameState::generateTactical(MoveList& moves) const {
+    assert(turn % 2 == team);
+
+    moves.size = 0;
+
+    const Bitboard own = teamBoard[team];
+    const Bitboard opp = teamBoard[TeamTraits<team>::opp];
+    const Bitboard oppBaseline = TeamTraits<team>::oppBaseline; //Erreichen der Grundlinie gibt einen Punkt (auer fr die Robbe)
+    const Bitboard threatened = threatenedHerzmuscheln<team>();
+
+    for (int piece = 0; piece < PIECE_TYPE_COUNT; ++piece) {
+        const PieceMoveTable& table = moveTable[team][piece];
+        const Bitboard targets = (piece == ROBBE) ? opp : (opp | oppBaseline);
+
+        Bitboard pieces = own & pieceBoard(piece);
+        while (pieces) {
+            const int square = popLsb(pieces);
+
+            Bitboard destinations = table.mask[square] & ~own;
+            if (!(threatened & squareBit(square))) destinations &= targets;
+
+            while (destinations) {
+                const int to = popLsb(destinations);
+                moves.push({ square, to, calcFlags<team>(square, to, piece) });
             }
-            if (pos.coords.x > 0) {
-                if (pos.coords.y < 6) pushMove(LEFT + DOWN + DOWN);
-                if (pos.coords.y > 1) pushMove(LEFT + UP + UP);
+        }
+    }
+}
+
+template<Team team>
+void GameState::generateQuiet(MoveList& moves) const {
+    assert(turn % 2 == team);
+
+    moves.size = 0;
+
+    const Bitboard own = teamBoard[team];
+    const Bitboard opp = teamBoard[TeamTraits<team>::opp];
+    const Bitboard oppBaseline = TeamTraits<team>::oppBaseline;
+    const Bitboard threatened = threatenedHerzmuscheln<team>();
+
+    for (int piece = 0; piece < PIECE_TYPE_COUNT; ++piece) {
+        const PieceMoveTable& table = moveTable[team][piece];
+        const Bitboard targets = (piece == ROBBE) ? ~(own | opp) : ~(own | opp | oppBaseline);
+
+        Bitboard pieces = own & pieceBoard(piece) & ~threatened;
+        while (pieces) {
+            const int square = popLsb(pieces);
+
+            Bitboard destinations = table.mask[square] & targets;
+            while (destinations) {
+                moves.push({ square, popLsb(destinations) }); //Ruhige Zge haben keine Flags
             }
-            break;
+        }
+    }
+}
+
+template<Team team>
+bool GameState::hasMoves() const {
+    assert(turn % 2 == team);
+
+    const Bitboard own = teamBoard[team];
+
+    for (int piece = 0; piece < PIECE_TYPE_COUNT; ++piece) {
+        Bitboard pieces = own & pieceBoard(piece);
+        while (pieces) {
+            if (moveTable[team][piece].mask[popLsb(pieces)] & ~own) return true;
         }
     }
 
-    return moves;
+    return false;
+}
+
+template<Team team>
+bool GameState::isTacticalMove(const Move& move) const {
+    assert(turn % 2 == team);
+
+    if (move.flags() & (CAPTURE | BASELINE)) return true; //Schlagen oder Punkt durch Erreichen der Grundlinie
+
+    return (threatenedHerzmuscheln<team>() & squareBit(move.from().square)) != 0;
 }
 
+template<Team team>
+bool GameState::isPseudoLegalMove(const Move& move) const {
+    assert(turn % 2 == team);
+
+    const Bitboard fromBit = squareBit(move.from().square);
+
+    if (!(teamBoard[team] & fromBit)) return false;
+
+    const Bitboard destinations = moveTable[team][pieceTypeAt(move.from().square)].mask[move.from().square] & ~teamBoard[team];
+
+    return (destinations & squareBit(move.to().square)) != 0;
+}
+
+void GameState::getPossibleMoves(MoveList& moves) const {
+    if (turn % 2 == ONE) getPossibleMoves<ONE>(moves);
+    else getPossibleMoves<TWO>(moves);
+}
+
+void GameState::generateTactical(MoveList& moves) const {
+    if (turn % 2 == ONE) generateTactical<ONE>(moves);
+    else generateTactical<TWO>(moves);
+}
+
+void GameState::generateQuiet(MoveList& moves) const {
+    if (turn % 2 == ONE) generateQuiet<ONE>(moves);
+    else generateQuiet<TWO>(moves);
+}
+
+bool GameState::hasMoves() const {
+    return (turn % 2 == ONE) ? hasMoves<ONE>() : hasMoves<TWO>();
+}
+
+bool GameState::isTacticalMove(const Move& move) const {
+    return (turn % 2 == ONE) ? isTacticalMove<ONE>(move) : isTacticalMove<TWO>(move);
+}
+
+bool GameState::isPseudoLegalMove(const Move& move) const {
+    return (turn % 2 == ONE) ? isPseudoLegalMove<ONE>(move) : isPseudoLegalMove<TWO>(move);
+}
 
 bool GameState::isOver() const { //berprft, ob das Spiel beendet ist
     if (turn % 2 == TWO) return false; //Ungerade Anzahl an Zgen
@@ -121,57 +311,50 @@ Team GameState::calcWinner() const {
     if (score[ONE] > score[TWO]) return ONE;
     if (score[ONE] < score[TWO]) return TWO;
 
-    std::vector<int> dist[TEAM_COUNT]{};
-
-    for (int square = 0; square < FIELD_COUNT; ++square) {
-        const Field& field = board[square];
-
-        if (!field.occupied) continue;
-        if (field.pieceType == ROBBE) continue;
+    /*Entscheidend ist der lexikographische Vergleich der absteigend sortierten Entfernungen der Nicht-Robben.
+    Das entspricht einem Vergleich der Anzahlen je Entfernung von 7 abwrts: Bei der ersten Entfernung mit unterschiedlicher
+    Anzahl gewinnt das Team mit mehr Spielsteinen, sofern das andere Team danach noch Spielsteine hat (sonst Gleichstand).*/
+    for (int distance = 7; distance >= 0; --distance) {
+        const int shift = 4 * distance;
+        const uint32_t countOne = (distanceCounts[ONE] >> shift) & 0xF;
+        const uint32_t countTwo = (distanceCounts[TWO] >> shift) & 0xF;
 
-        const Position pos{ square };
+        if (countOne == countTwo) continue;
 
-        dist[field.team].push_back(
-            (field.team == ONE) ? pos.coords.x : (7 - pos.coords.x)
-        );
-    }
-
-    std::sort(dist[ONE].begin(), dist[ONE].end(), std::greater<>());
-    std::sort(dist[TWO].begin(), dist[TWO].end(), std::greater<>());
+        const uint32_t below = ((uint32_t)1 << shift) - 1; //Alle kleineren Entfernungen
 
-    for (int i = 0; i < std::min(dist[ONE].size(), dist[TWO].size()); ++i) {
-        if (dist[ONE][i] > dist[TWO][i]) return ONE;
-        if (dist[ONE][i] < dist[TWO][i]) return TWO;
+        if (countOne > countTwo) return (distanceCounts[TWO] & below) ? ONE : NO_TEAM;
+        return (distanceCounts[ONE] & below) ? TWO : NO_TEAM;
     }
 
     return NO_TEAM;
 }
 
+template<Team team>
 SaveState GameState::makeMove(const Move& move) {
-    assert(move.from.square != move.to.square);
+    assert(move.from().square != move.to().square);
+    assert(turn % 2 == team);
 
-    Field& from = board[move.from.square];
-    Field& to = board[move.to.square];
-
-    int team = turn % 2;
-    uint8_t oppBaseline = (team == ONE) ? 7 : 0;
+    Field from = getField(move.from().square);
+    Field to = getField(move.to().square);
 
     assert(from.occupied);
     assert(from.team == team);
     assert(!to.occupied || to.team != team);
+    assert(move.flags() == annotateMove(move).flags());
 
     SaveState saveState{ from, to, score[team], hash };
 
-    int points = (
-        (to.occupied && (from.stacked || to.stacked)) +
-        (move.to.coords.x == oppBaseline && from.pieceType != ROBBE)
-        );
+    toggleField(move.from().square, from);
+    toggleField(move.to().square, to);
+
+    int points = move.points();
 
     if (points > 0) {
         if (to.occupied) {
             to.occupied = false;
-            hash ^= zobrist.piece[move.to.square][to.team][to.pieceType];
-            if (to.stacked) hash ^= zobrist.stacked[move.to.square];
+            hash ^= zobrist.piece[move.to().square][to.team][to.pieceType];
+            if (to.stacked) hash ^= zobrist.stacked[move.to().square];
         }
         if (score[team] > 0) hash ^= zobrist.score[team][score[team] - 1];
         score[team] += points;
@@ -179,22 +362,24 @@ SaveState GameState::makeMove(const Move& move) {
     }
     else {
         if (to.occupied) {
-            hash ^= zobrist.piece[move.to.square][to.team][to.pieceType];
+            hash ^= zobrist.piece[move.to().square][to.team][to.pieceType];
         }
 
         to.stacked = to.occupied || from.stacked;
-        if (to.stacked) hash ^= zobrist.stacked[move.to.square];
+        if (to.stacked) hash ^= zobrist.stacked[move.to().square];
 
         to.occupied = true;
         to.team = from.team;
         to.pieceType = from.pieceType;
 
-        hash ^= zobrist.piece[move.to.square][to.team][to.pieceType];
+        hash ^= zobrist.piece[move.to().square][to.team][to.pieceType];
     }
 
     from.occupied = false;
-    hash ^= zobrist.piece[move.from.square][from.team][from.pieceType];
-    if (from.stacked) hash ^= zobrist.stacked[move.from.square];
+    hash ^= zobrist.piece[move.from().square][from.team][from.pieceType];
+    if (from.stacked) hash ^= zobrist.stacked[move.from().square];
+
+    toggleField(move.to().square, to);
 
     hash ^= zobrist.turn[turn];
     ++turn;
@@ -205,16 +390,120 @@ SaveState GameState::makeMove(const Move& move) {
     return saveState;
 }
 
+template<Team team>
 void GameState::unmakeMove(const Move& move, const SaveState& saveState) {
-    assert(move.from.square != move.to.square);
+    assert(move.from().square != move.to().square);
     assert(saveState.hash != hash);
 
     --turn;
 
-    assert(saveState.from.team == turn % 2);
+    assert(turn % 2 == team);
+    assert(saveState.from.team == team);
 
-    board[move.from.square] = saveState.from;
-    board[move.to.square] = saveState.to;
-    score[turn % 2] = saveState.score;
+    toggleField(move.to().square, getField(move.to().square)); //Das Startfeld ist nach makeMove immer leer
+
+    toggleField(move.from().square, saveState.from);
+    toggleField(move.to().square, saveState.to);
+    score[team] = (uint8_t)saveState.score;
     hash = saveState.hash;
-}
\ No newline at end of file
+}
+
+SaveState GameState::makeMove(const Move& move) {
+    return (turn % 2 == ONE) ? makeMove<ONE>(move) : makeMove<TWO>(move);
+}
+
+void GameState::unmakeMove(const Move& move, const SaveState& saveState) {
+    if ((turn - 1) % 2 == ONE) unmakeMove<ONE>(move, saveState);
+    else unmakeMove<TWO>(move, saveState);
+}
+
+void GameState::makeNullMove() {
+    assert(turn < TURN_LIMIT);
+
+    hash ^= zobrist.turn[turn];
+    ++turn;
+    hash ^= zobrist.turn[turn];
+}
+
+void GameState::unmakeNullMove() {
+    assert(turn > 0);
+
+    hash ^= zobrist.turn[turn];
+    --turn;
+    hash ^= zobrist.turn[turn];
+}
+
+template<Team team>
+uint64_t GameState::perft(const int depth) {
+    assert(depth > 0);
+
+    if (isOver()) return 1;
+
+    MoveList moves;
+    getPossibleMoves<team>(moves);
+
+    if (depth == 1) return moves.size; //Bulk Counting: jeder Zug ergibt genau ein Blatt, ob das Spiel danach vorbei ist oder nicht
+
+    uint64_t nodes = 0;
+
+    for (const MoveValuePair& entry : moves) {
+        SaveState saveState = makeMove<team>(entry.move);
+        nodes += perft<TeamTraits<team>::opp>(depth - 1);
+        unmakeMove<team>(entry.move, saveState);
+    }
+
+    return nodes;
+}
+
+uint64_t GameState::perft(const int depth) {
+    return (turn % 2 == ONE) ? perft<ONE>(depth) : perft<TWO>(depth);
+}
+
+uint64_t GameState::divide(const int depth) {
+    assert(depth > 0);
+
+    MoveList moves;
+    getPossibleMoves(moves);
+
+    uint64_t nodes = 0;
+
+    for (const MoveValuePair& entry : moves) {
+        const Move& move = entry.move;
+
+        SaveState saveState = makeMove(move);
+        const uint64_t moveNodes = (depth == 1 || isOver()) ? 1 : perft(depth - 1);
+        unmakeMove(move, saveState);
+
+        printf("(%i, %i) -> (%i, %i): %llu\n",
+            move.from().coords.x,
+            move.from().coords.y,
+            move.to().coords.x,
+            move.to().coords.y,
+            (unsigned long long)moveNodes
+        );
+
+        nodes += moveNodes;
+    }
+
+    printf("total: %llu\n", (unsigned long long)nodes);
+
+    return nodes;
+}
+
+//Die template<Team>-Varianten werden auch von AlphaBeta und MovePicker aufgerufen
+template void GameState::getPossibleMoves<ONE>(MoveList& moves) const;
+template void GameState::getPossibleMoves<TWO>(MoveList& moves) const;
+template void GameState::generateTactical<ONE>(MoveList& moves) const;
+template void GameState::generateTactical<TWO>(MoveList& moves) const;
+template void GameState::generateQuiet<ONE>(MoveList& moves) const;
+template void GameState::generateQuiet<TWO>(MoveList& moves) const;
+template bool GameState::hasMoves<ONE>() const;
+template bool GameState::hasMoves<TWO>() const;
+template bool GameState::isTacticalMove<ONE>(const Move& move) const;
+template bool GameState::isTacticalMove<TWO>(const Move& move) const;
+template bool GameState::isPseudoLegalMove<ONE>(const Move& move) const;
+template bool GameState::isPseudoLegalMove<TWO>(const Move& move) const;
+template SaveState GameState::makeMove<ONE>(const Move& move);
+template SaveState GameState::makeMove<TWO>(const Move& move);
+template void GameState::unmakeMove<ONE>(const Move& move, const SaveState& saveState);
+template void GameState::unmakeMove<TWO>(const Move& move, const SaveState& saveState);
\ No newline at end of file
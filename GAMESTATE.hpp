@@ -1,4 +1,5 @@
 #pragma once
+#include "BITBOARD.hpp"
 #include "DEFINITION.hpp"
 #include <stdint.h>
 #include <string>
@@ -8,46 +9,120 @@
 #define MAX_SCORE 2 //Bernsteine
 #define TURN_LIMIT 60 //Zuglimit
 
+#define BASELINE_ONE 0x00000000000000FFull //Grundlinie von Team 1 (x = 0)
+#define BASELINE_TWO 0xFF00000000000000ull //Grundlinie von Team 2 (x = 7)
+
+/*Alles, was bei der Zuggenerierung und in makeMove vom Team am Zug abhngt.
+Die template<Team>-Varianten in GameState lesen es hier ab, sodass turn % 2 und die Verzweigungen nach dem Team beim Kompilieren wegfallen.*/
+template<Team team> struct TeamTraits;
+
+template<> struct TeamTraits<ONE> {
+    static constexpr Team opp = TWO;
+    static constexpr Bitboard oppBaseline = BASELINE_TWO; //Grundlinie, deren Erreichen einen Punkt gibt
+    static Bitboard backward(const Bitboard bitboard) { return bitboard >> 8; } //Verschiebt alle Felder um eine Spalte entgegen der Spielrichtung
+};
+
+template<> struct TeamTraits<TWO> {
+    static constexpr Team opp = ONE;
+    static constexpr Bitboard oppBaseline = BASELINE_ONE;
+    static Bitboard backward(const Bitboard bitboard) { return bitboard << 8; }
+};
+
 /*Diese Klasse reprsentiert den aktuelles Zustand des (Ostsee-)Schachspiels
-Sie enthlt Informationen ber das Schachbrett, den Spielzug, den Punktestand und den Hashwert des Zustands.*/
+Sie enthlt Informationen ber das Schachbrett, den Spielzug, den Punktestand und den Hashwert des Zustands.
+Das Brett besteht nur aus Bitboards, damit eine Stellung in 64 Byte passt und schnell kopiert werden kann (siehe COPY_MAKE in AlphaBeta).*/
 class GameState {
 private:
-    struct { //Speichert Zobrist-Hashes fr verschiedene Aspekte des Spielzustands.
-        uint64_t piece[FIELD_COUNT][TEAM_COUNT][PIECE_TYPE_COUNT];
-        uint64_t stacked[FIELD_COUNT];
-        uint64_t score[TEAM_COUNT][MAX_SCORE];
-        uint64_t turn[TURN_LIMIT];
-    } zobrist;
-/*Zobrist-Hashing ist eine Technik, um den Zustand eines Schachbretts effizient zu hashen und Kollisionen zu minimieren.
-* 
-Einzigartigkeit der Hash-Codes:
-Zobrist-Hashing generiert fr jede Schachposition einen fast eindeutigen Index.
-Selbst hnliche Positionen erzeugen unterschiedliche Hash-Codes.
-Dies ist entscheidend fr die Verwendung in Hash-Tabellen wie Transpositionstabellen.
-
-Effiziente Speicherung und Suche:
-Schach-Engines verwenden Hash-Tabellen, um bereits berechnete Positionen zu speichern.
-Zobrist-Hashes ermglichen schnelle und platzsparende Suchvorgnge in diesen Tabellen.
-
-Reproduzierbarkeit:
-Die Verwendung von Zobrist-Hashes ermglicht die Portabilitt von Schachbchern und Datenbanken ber verschiedene Plattformen hinweg.
-Die gleichen Hash-Codes knnen auf unterschiedlichen Maschinen verwendet werden.*/
+    void toggleField(const int square, const Field& field); //Schaltet die Bits eines besetzten Feldes in den Bitboards um
+
+    template<Team team>
+    Bitboard threatenedHerzmuscheln() const; //Herzmuscheln, vor denen eine gegnerische Moewe steht
+
+    template<Team team>
+    uint8_t calcFlags(const int from, const int to, const int pieceType) const; //MoveFlags eines Zugs des Teams am Zug
+
+    template<Team team>
+    uint64_t perft(const int depth);
 
 public:
-    Field board[FIELD_COUNT]{};
-    int turn = 0;
-    int score[TEAM_COUNT]{};
+    Bitboard teamBoard[TEAM_COUNT]{}; //Alle Felder eines Teams
+    Bitboard typeBoard[2]{}; //PieceType als zwei Bitebenen: Bit 0 des PieceTypes in typeBoard[0], Bit 1 in typeBoard[1]
+    Bitboard stackedBoard = 0; //Alle Felder mit gestapelten Spielsteinen
     uint64_t hash = 0;
+    int turn = 0;
+    uint8_t score[TEAM_COUNT]{};
+    uint32_t distanceCounts[TEAM_COUNT]{}; //Anzahl der Nicht-Robben je Entfernung zur eigenen Grundlinie, 4 Bit pro Entfernung (fr calcWinner)
+
+    Bitboard pieceBoard(const int pieceType) const { //Alle Felder eines PieceTypes (beide Teams)
+        const Bitboard occupied = teamBoard[ONE] | teamBoard[TWO];
+        const Bitboard low = (pieceType & 1) ? typeBoard[0] : (occupied & ~typeBoard[0]);
+        const Bitboard high = (pieceType & 2) ? typeBoard[1] : (occupied & ~typeBoard[1]);
+        return low & high;
+    }
+
+    PieceType pieceTypeAt(const int square) const { //PieceType eines besetzten Feldes
+        return (PieceType)(((typeBoard[0] >> square) & 1) | (((typeBoard[1] >> square) & 1) << 1));
+    }
+
+    Field getField(const int square) const; //Setzt ein Field aus den Bitboards zusammen
+
+    void setField(const int square, const Field& field); //Ersetzt den Inhalt eines Feldes (z.B. beim Parsen), ndert den Hash nicht
+
+    void getPossibleMoves(MoveList& moves) const; //Schreibt die mglichen Zge in moves.
+
+    void generateTactical(MoveList& moves) const; //Nur schlagende, punktende und von einer Moewe bedrohte Herzmuschel-Zge (fr quiesce)
+
+    void generateQuiet(MoveList& moves) const; //Alle brigen Zge, zusammen mit generateTactical also getPossibleMoves
 
-    GameState();
+    bool hasMoves() const; //Prft ob das Team am Zug berhaupt ziehen kann, ohne die Zge zu erzeugen
 
-    std::vector<Move> getPossibleMoves() const; //Gibt eine Liste der mglichen Zge zurck.
+    Move annotateMove(const Move& move) const; //Ergnzt die MoveFlags eines Zugs ohne Flags (z.B. vom Server oder ein Killerzug)
+
+    bool isTacticalMove(const Move& move) const; //Prft ob ein Zug zu generateTactical gehrt, die Flags mssen gesetzt sein
+
+    bool isPseudoLegalMove(const Move& move) const; //Prft ob ein Zug (z.B. ein Killer aus einer anderen Stellung) hier mglich ist
 
     bool isOver() const; //Prft ob das Spiel vorbei ist
 
-    Team calcWinner() const; //Ermittelt den Gewinner des Spiels
+    Team calcWinner() const; //Ermittelt den Gewinner des Spiels, ohne das Brett abzulaufen
 
-    SaveState makeMove(const Move& move); //Fhrt einen Zug im Spiel aus
+    SaveState makeMove(const Move& move); //Fhrt einen Zug im Spiel aus, die Flags mssen gesetzt sein
 
     void unmakeMove(const Move& move, const SaveState& saveState); //Zug widerrufen
-};
\ No newline at end of file
+
+    void makeNullMove(); //bergibt den Zug an den Gegner, ohne einen Spielstein zu bewegen (Null Move Pruning)
+
+    void unmakeNullMove();
+
+    uint64_t perft(const int depth); //Zhlt die Blattknoten bis zur Tiefe depth (Test und Benchmark der Zuggenerierung)
+
+    /*Dieselben Funktionen fr ein beim Kompilieren bekanntes Team am Zug (team == turn % 2).
+    Die Funktionen ohne template-Parameter verzweigen einmal und rufen diese auf. Die Suche verzweigt nur einmal an der Wurzel.*/
+    template<Team team>
+    void getPossibleMoves(MoveList& moves) const;
+
+    template<Team team>
+    void generateTactical(MoveList& moves) const;
+
+    template<Team team>
+    void generateQuiet(MoveList& moves) const;
+
+    template<Team team>
+    bool hasMoves() const;
+
+    template<Team team>
+    bool isTacticalMove(const Move& move) const;
+
+    template<Team team>
+    bool isPseudoLegalMove(const Move& move) const;
+
+    template<Team team>
+    SaveState makeMove(const Move& move);
+
+    template<Team team>
+    void unmakeMove(const Move& move, const SaveState& saveState); //team ist das Team, das den Zug ausgefhrt hat
+
+    uint64_t divide(const int depth); //Wie perft, gibt aber die Knotenzahl fr jeden Zug der Wurzel aus
+};
+
+static_assert(sizeof(GameState) <= 64, "GameState soll in eine Cache-Line passen");
\ No newline at end of file
@@ -0,0 +1,156 @@
+#include "DEFINITION.hpp"
+#include "GAMESTATE.hpp"
+#include "MOVEPICKER.hpp"
+#include <assert.h>
+#include <limits.h>
+#include <algorithm>
+
+MovePicker::MovePicker(const GameState& gameState, const Move& ttMove, const Move* killers, const Move& counterMove,
+    const History& history)
+    : gameState(gameState), history(history), ttMove(ttMove), killers(killers), counterMove(counterMove) {}
+
+void History::setButterfly(const bool butterfly) {
+    if (this->butterfly == butterfly) return;
+
+    this->butterfly = butterfly;
+    age(INT_MAX);
+}
+
+void History::update(const GameState& gameState, const Team team, const Move& move, const int bonus) {
+    assert(bonus >= -HISTORY_MAX && bonus <= HISTORY_MAX);
+
+    int& value = table[team][index(gameState, move)];
+    value += bonus - value * (bonus < 0 ? -bonus : bonus) / HISTORY_MAX;
+
+    assert(value >= -HISTORY_MAX && value <= HISTORY_MAX);
+}
+
+void History::age(const int divisor) {
+    assert(divisor > 0);
+
+    for (int team = 0; team < TEAM_COUNT; ++team) {
+        for (int& value : table[team]) value /= divisor;
+    }
+}
+
+bool MovePicker::isKiller(const Move& move) const {
+    if (killers == nullptr) return false;
+
+    for (int i = 0; i < KILLER_COUNT; ++i) {
+        if (move == killers[i]) return true;
+    }
+
+    return false;
+}
+
+bool MovePicker::isSearched(const Move& move) const {
+    if (move == ttMove) return true;
+    if (stage > KILLER_STAGE && isKiller(move)) return true;
+    if (stage > COUNTER_MOVE_STAGE && move == counterMove) return true;
+
+    return false;
+}
+
+template<Team team>
+bool MovePicker::isQuietCandidate(const Move& move, Move& annotated) const {
+    if (move == Move{} || move == ttMove) return false;
+    if (!gameState.isPseudoLegalMove<team>(move)) return false;
+
+    annotated = gameState.annotateMove(move); //Die Flags stammen aus einer anderen Stellung
+
+    return !gameState.isTacticalMove<team>(annotated); //Taktische Zge wurden bereits in TACTICAL_STAGE geliefert
+}
+
+Move MovePicker::pickBest(MoveList& moves) {
+    assert(index < moves.size);
+
+    int best = index;
+    for (int i = index + 1; i < moves.size; ++i) {
+        if (moves.moves[i].value > moves.moves[best].value) best = i;
+    }
+
+    std::swap(moves.moves[index], moves.moves[best]);
+
+    return moves.moves[index++].move;
+}
+
+int tacticalValue(const Move& move) { //Punktende Zge vor Stapeln vor Drohungen
+    return move.points() * 2 + ((move.flags() & CAPTURE) != 0);
+}
+
+template<Team team>
+Move MovePicker::next() {
+    switch (stage) {
+    case TT_MOVE_STAGE:
+        stage = GENERATE_TACTICAL_STAGE;
+        if (ttMove != Move{}) return ttMove;
+        //fallthrough
+
+    case GENERATE_TACTICAL_STAGE:
+        gameState.generateTactical<team>(tactical);
+
+        for (MoveValuePair& entry : tactical) {
+            entry.value = tacticalValue(entry.move);
+        }
+
+        stage = TACTICAL_STAGE;
+        index = 0;
+        //fallthrough
+
+    case TACTICAL_STAGE:
+        while (index < tactical.size) {
+            const Move move = pickBest(tactical);
+            if (!isSearched(move)) return move;
+        }
+
+        stage = KILLER_STAGE;
+        index = 0;
+        //fallthrough
+
+    case KILLER_STAGE:
+        while (killers != nullptr && index < KILLER_COUNT) {
+            Move killer;
+            if (isQuietCandidate<team>(killers[index++], killer)) return killer;
+        }
+
+        stage = COUNTER_MOVE_STAGE;
+        //fallthrough
+
+    case COUNTER_MOVE_STAGE:
+        stage = GENERATE_QUIET_STAGE;
+
+        if (!isKiller(counterMove)) {
+            Move move;
+            if (isQuietCandidate<team>(counterMove, move)) return move;
+        }
+        //fallthrough
+
+    case GENERATE_QUIET_STAGE:
+        gameState.generateQuiet<team>(quiets);
+
+        for (MoveValuePair& entry : quiets) {
+            entry.value = history.get(gameState, team, entry.move);
+        }
+
+        stage = QUIET_STAGE;
+        index = 0;
+        //fallthrough
+
+    case QUIET_STAGE:
+        while (index < quiets.size) {
+            const Move move = pickBest(quiets);
+            if (!isSearched(move)) return move;
+        }
+
+        stage = DONE_STAGE;
+        //fallthrough
+
+    case DONE_STAGE:
+        break;
+    }
+
+    return Move{};
+}
+
+template Move MovePicker::next<ONE>();
+template Move MovePicker::next<TWO>();
\ No newline at end of file
@@ -0,0 +1,78 @@
+#pragma once
+#include "DEFINITION.hpp"
+#include "GAMESTATE.hpp"
+#include <stdint.h>
+
+#define KILLER_COUNT 2 //Killerzge pro Ply
+#define HISTORY_MAX 16384 //Betrag, den ein Historywert nicht berschreiten kann
+
+enum MovePickerStage { //Phasen, in denen der MovePicker Zge liefert
+    TT_MOVE_STAGE,
+    GENERATE_TACTICAL_STAGE,
+    TACTICAL_STAGE,
+    KILLER_STAGE,
+    COUNTER_MOVE_STAGE,
+    GENERATE_QUIET_STAGE,
+    QUIET_STAGE,
+    DONE_STAGE
+};
+
+/*Bewertet ruhige Zge danach, ob sie in frheren Knoten einen Beta-Cutoff ausgelst haben, getrennt nach Team.
+Standardmig wird nach PieceType und Zielfeld unterschieden, mit butterfly nach Start- und Zielfeld.
+update nhert einen Wert nur um den Anteil (1 - |value| / HISTORY_MAX) des Bonus an die Grenze an, so bleiben die Werte
+beschrnkt und ber eine ganze Partie vergleichbar. age baut die Werte zwischen zwei Zgen ab.*/
+class History {
+private:
+    int table[TEAM_COUNT][FIELD_COUNT * FIELD_COUNT]{};
+    bool butterfly = false;
+
+    int index(const GameState& gameState, const Move& move) const {
+        const int from = move.from().square;
+        return (butterfly ? from : gameState.pieceTypeAt(from)) * FIELD_COUNT + move.to().square;
+    }
+
+public:
+    void setButterfly(const bool butterfly); //Wechselt die Indizierung und lscht dabei alle Werte
+
+    int get(const GameState& gameState, const Team team, const Move& move) const {
+        return table[team][index(gameState, move)];
+    }
+
+    void update(const GameState& gameState, const Team team, const Move& move, const int bonus); //Negativer bonus fr Zge ohne Cutoff
+
+    void age(const int divisor); //Teilt alle Werte durch divisor
+};
+
+/*Liefert die Zge eines Knotens schrittweise: zuerst den Zug aus der Transpositionstabelle,
+dann schlagende und punktende Zge, dann die Killerzge, dann den Konterzug auf den vorigen Zug
+und zuletzt die ruhigen Zge nach History sortiert.
+Erzeugt, bewertet und sortiert wird erst, wenn eine Phase erreicht wird. Bei einem Beta-Cutoff nach den ersten Zgen
+fllt die Arbeit fr die restlichen Phasen weg.*/
+class MovePicker {
+private:
+    const GameState& gameState;
+    const History& history;
+    const Move ttMove;
+    const Move* killers;
+    const Move counterMove; //Ruhiger Zug, der zuletzt auf denselben gegnerischen Zug einen Beta-Cutoff ausgelst hat
+    MovePickerStage stage = TT_MOVE_STAGE;
+    MoveList tactical;
+    MoveList quiets;
+    int index = 0;
+
+    bool isKiller(const Move& move) const; //Ist der Zug einer der Killerzge dieser Ply?
+
+    bool isSearched(const Move& move) const; //Wurde der Zug schon in einer frheren Phase geliefert?
+
+    template<Team team>
+    bool isQuietCandidate(const Move& move, Move& annotated) const; //Prft einen Killer- oder Konterzug aus einer anderen Stellung
+
+    Move pickBest(MoveList& moves); //Whlt den Zug mit dem hchsten value ab index (Selection Sort, nur so weit wie ntig)
+
+public:
+    MovePicker(const GameState& gameState, const Move& ttMove, const Move* killers, const Move& counterMove,
+        const History& history);
+
+    template<Team team>
+    Move next(); //Gibt den nchsten Zug zurck oder Move{}, wenn alle Zge geliefert wurden, team ist das Team am Zug
+};
@@ -0,0 +1,50 @@
+#pragma once
+#include "BITBOARD.hpp"
+#include "DEFINITION.hpp"
+#include "GAMESTATE.hpp"
+#include <stdint.h>
+
+#define MAX_DESTINATIONS 8 //Maximale Anzahl an Zielfeldern eines Spielsteins (Robbe)
+
+/*Vorberechnete Zielfelder eines PieceTypes fr ein Team.
+Die Randprfungen (x < 7, y > 0, ...) werden beim Kompilieren erledigt, sodass die Zuggenerierung
+nur noch mask[square] mit den nicht vom eigenen Team besetzten Feldern verknpfen muss.*/
+struct PieceMoveTable {
+    Bitboard mask[FIELD_COUNT]; //Alle Zielfelder als Bitboard
+};
+
+struct Offset { //Schritt eines Spielsteins, dx zeigt in Spielrichtung von Team 1
+    int dx, dy;
+};
+
+constexpr Offset pieceOffsets[PIECE_TYPE_COUNT][MAX_DESTINATIONS]{
+    { { 1, 1 }, { 1, -1 } }, // HERZMUSCHEL
+    { { 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 } }, // MOEWE
+    { { 1, 0 }, { 1, 1 }, { 1, -1 }, { -1, 1 }, { -1, -1 } }, // SEESTERN
+    { { 2, 1 }, { 2, -1 }, { -2, 1 }, { -2, -1 }, { 1, 2 }, { 1, -2 }, { -1, 2 }, { -1, -2 } } // ROBBE
+};
+
+constexpr int pieceOffsetCount[PIECE_TYPE_COUNT]{ 2, 4, 5, 8 };
+
+constexpr PieceMoveTable generatePieceMoveTable(const Team team, const PieceType pieceType) {
+    PieceMoveTable table{};
+
+    const int forward = (team == ONE) ? 1 : -1; //Team 2 zieht in Richtung x = 0
+
+    for (int square = 0; square < FIELD_COUNT; ++square) {
+        const int x = square >> 3;
+        const int y = square & 7;
+
+        for (int i = 0; i < pieceOffsetCount[pieceType]; ++i) {
+            const int toX = x + forward * pieceOffsets[pieceType][i].dx;
+            const int toY = y + pieceOffsets[pieceType][i].dy;
+
+            if (toX < 0 || toX > 7 || toY < 0 || toY > 7) continue;
+
+            const int to = toX * 8 + toY;
+            table.mask[square] |= (Bitboard)1 << to;
+        }
+    }
+
+    return table;
+}
@@ -70,7 +70,7 @@ std::string Network::receive(const std::string& delim) {
 Packet Network::receiveRoomPacket() {
     std::string data = receive("</room>");
 
-    Time time = std::chrono::system_clock::now();
+    Time time = std::chrono::steady_clock::now();
 
     if (data.empty()) throw std::runtime_error("Didn't receive room message");
 
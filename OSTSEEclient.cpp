@@ -4,9 +4,11 @@
 #include <chrono>
 #include <pugixml.hpp>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string>
 
 #include "ALPHABETA.hpp"
+#include "BENCHMARK.hpp"
 #include "DEFINITION.hpp"
 #include "GAMESTATE.hpp"
 #include "NETWORK.hpp"
@@ -34,7 +36,7 @@ bool defaultRoomPacketHandle(const Packet& packet) {
     return false;
 }
 
-void gameLoop(Network& network) {
+void gameLoop(Network& network, const SearchConfig& config) {
     GameState gameState{};
 
     while (true) {
@@ -49,29 +51,42 @@ void gameLoop(Network& network) {
         }
     }
 
-    AlphaBeta alphaBeta{ gameState };
+    AlphaBeta alphaBeta{ gameState, config };
+    bool moveSent = false; //Das nächste Memento enthält den eigenen Zug, danach wird gepondert
 
     while (true) {
         Packet roomPacket = network.receiveRoomPacket();
 
         if (roomPacket.dataClass == "moveRequest") {
+            alphaBeta.stopPondering();
+
             Move move = alphaBeta.iterativeDeepening(roomPacket.time);
-            assert(move.from != move.to);
+            assert(move.from() != move.to());
 
             network.sendRoomPacket(PARSER::encodeMove(move));
+            alphaBeta.recordSend(std::chrono::steady_clock::now());
 
             printf("INFO: Sent move (%i, %i) -> (%i, %i) in " "ms\n",
-                move.from.coords.x,
-                move.from.coords.y,
-                move.to.coords.x,
-                move.to.coords.y,
-                std::chrono::duration_cast<MS>(std::chrono::system_clock::now() - roomPacket.time).count()
+                move.from().coords.x,
+                move.from().coords.y,
+                move.to().coords.x,
+                move.to().coords.y,
+                std::chrono::duration_cast<MS>(std::chrono::steady_clock::now() - roomPacket.time).count()
             );
+
+            moveSent = true;
         }
         else if (roomPacket.dataClass == "memento") {
+            const Move ponderMove = alphaBeta.stopPondering(); //gameState ist die Wurzel der Ponder-Suche
+
             pugi::xml_node xml = roomPacket.data.child("state");
-            Move move = PARSER::parseMove(xml.child("lastMove"));
+            Move move = gameState.annotateMove(PARSER::parseMove(xml.child("lastMove")));
             gameState.makeMove(move);
+
+            if (ponderMove != Move{}) printf("INFO: Ponder %s\n", (move == ponderMove) ? "hit" : "miss");
+
+            if (moveSent && config.ponder) alphaBeta.startPondering();
+            moveSent = false;
         }
         else {
             if (defaultRoomPacketHandle(roomPacket)) return;
@@ -80,12 +95,46 @@ void gameLoop(Network& network) {
 }
 
 int main(int argc, char** argv) {
+    //Benchmarks ohne Server: --perft <Tiefe>, --divide <Tiefe> [Stellung], --copymake <Tiefe>, --search <Tiefe> oder --smp <Tiefe>
+    if (argc >= 3 && std::string(argv[1]) == "--perft") {
+        Benchmark::perft(atoi(argv[2]));
+        return 0;
+    }
+
+    if (argc >= 3 && std::string(argv[1]) == "--divide") {
+        Benchmark::divide(atoi(argv[2]), (argc >= 4) ? atoi(argv[3]) : 0);
+        return 0;
+    }
+
+    if (argc >= 3 && std::string(argv[1]) == "--copymake") {
+        Benchmark::copyMake(atoi(argv[2]));
+        return 0;
+    }
+
+    if (argc >= 3 && std::string(argv[1]) == "--search") {
+        Benchmark::search(atoi(argv[2]));
+        return 0;
+    }
+
+    if (argc >= 3 && std::string(argv[1]) == "--smp") {
+        Benchmark::smp(atoi(argv[2]));
+        return 0;
+    }
+
+    SearchConfig config{};
+
+    for (int i = 1; i < argc; ++i) { //--threads <Anzahl> für Lazy SMP, zusätzlich --abdada für ABDADA, --noponder schaltet Pondering ab
+        if (std::string(argv[i]) == "--threads" && i + 1 < argc) config.threads = atoi(argv[i + 1]);
+        if (std::string(argv[i]) == "--abdada") config.parallelMode = ABDADA;
+        if (std::string(argv[i]) == "--noponder") config.ponder = false;
+    }
+
     std::string host = "localhost";
     int port = 13050;
     std::string reservation;
 
     Network network{ host, port, reservation };
-    gameLoop(network);
+    gameLoop(network, config);
     network.close();
 
     return 0;
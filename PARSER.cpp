@@ -23,12 +23,9 @@ Position PARSER::parsePosition(const pugi::xml_node& xml) {
 }
 //Analysiert einen XML-Zug und gibt ein Move-Objekt zurck. Sie verwendet parsePosition, um die Start- und Zielpositionen zu extrahieren.
 Move PARSER::parseMove(const pugi::xml_node& xml) {
-    Move move;
+    Move move{ parsePosition(xml.child("from")), parsePosition(xml.child("to")) }; //Ohne Flags, siehe GameState::annotateMove
 
-    move.from = parsePosition(xml.child("from"));
-    move.to = parsePosition(xml.child("to"));
-
-    assert(move.from != move.to);
+    assert(move.from() != move.to());
 
     return move;
 }
@@ -81,9 +78,9 @@ void PARSER::parseGameState(const pugi::xml_node& xml, GameState &gameState) {
     pugi::xml_node pieces = xml.child("board").child("pieces");
     for (const pugi::xml_node& piece : pieces.children()) {
         Position position = parsePosition(piece.child("coordinates"));
-        Field& field = gameState.board[position.square];
+        Field field{};
 
-        assert(!field.occupied);
+        assert(!gameState.getField(position.square).occupied);
 
         field.occupied = true;
 
@@ -93,6 +90,8 @@ void PARSER::parseGameState(const pugi::xml_node& xml, GameState &gameState) {
         field.stacked = parsePieceStacked(child.attribute("count"));
 
         field.stacked = 0;
+
+        gameState.setField(position.square, field);
     }
 }
 //Codiert eine Koordinate als String. Wird verwendet, um die Koordinaten in XML zu speichern.
@@ -119,9 +118,9 @@ std::string PARSER::encodeMove(const Move& move) {
     std::string xml;
 
     xml.append("<data class=\"move\"><from ");
-    xml.append(encodePosition(move.from));
+    xml.append(encodePosition(move.from()));
     xml.append("/><to ");
-    xml.append(encodePosition(move.to));
+    xml.append(encodePosition(move.to()));
     xml.append("/></data>");
 
     return xml;
@@ -0,0 +1,89 @@
+#include "TIMEMANAGER.hpp"
+#include "DEFINITION.hpp"
+#include "EVALUATION.hpp"
+#include "GAMESTATE.hpp"
+#include <algorithm>
+#include <assert.h>
+#include <chrono>
+#include <limits.h>
+
+TimeManager::TimeManager(const int timeLimit) : timeLimit(timeLimit) {
+    assert(timeLimit > 0);
+}
+
+void TimeManager::startSearch(const Time start, const GameState& gameState, const bool infinite) {
+    this->start = start;
+    searchEnd = start;
+
+    hardLimit = infinite ? INT_MAX : std::max(timeLimit - latency, (int)((long long)timeLimit * MIN_HARD_LIMIT_PERCENT / 100));
+    softLimit = infinite ? INT_MAX : (int)((long long)hardLimit * SOFT_LIMIT_PERCENT / 100);
+
+    remainingTurns = TURN_LIMIT - gameState.turn;
+    lastBest = Move{};
+    lastScore = 0;
+    stableIterations = 0;
+}
+
+int TimeManager::elapsed() const {
+    return (int)std::chrono::duration_cast<MS>(std::chrono::steady_clock::now() - start).count();
+}
+
+bool TimeManager::nextIteration(const int depth, const Move& bestMove, const int score) {
+    if (score >= WINNING_SCORE || score <= -WINNING_SCORE) return false; //Gewinn oder Verlust steht fest
+    if (depth >= remainingTurns) return false; //Die Suche reicht bis zum Zuglimit, nur reduzierte Zge wrden noch tiefer gesucht
+
+    int percent = 100;
+
+    if (lastBest != Move{}) { //Nach der ersten Iteration gilt die unvernderte weiche Grenze
+        if (bestMove != lastBest) percent = UNSTABLE_PERCENT;
+        else if (stableIterations + 1 >= STABLE_ITERATIONS) percent = STABLE_PERCENT;
+
+        if (score <= lastScore - SCORE_DROP) percent = std::max(percent, SCORE_DROP_PERCENT);
+    }
+
+    stableIterations = (bestMove == lastBest) ? stableIterations + 1 : 0;
+    lastBest = bestMove;
+    lastScore = score;
+
+    const long long limit = std::min((long long)softLimit * percent / 100, (long long)hardLimit);
+
+    return elapsed() < limit;
+}
+
+void TimeManager::stopSearch() {
+    searchEnd = std::chrono::steady_clock::now();
+}
+
+void TimeManager::recordSend(const Time sent) {
+    const int sample = (int)std::chrono::duration_cast<MS>(sent - searchEnd).count();
+
+    latency = std::max(sample, (latency * 3 + sample) / 4); //Steigt sofort, fllt nur langsam
+}
+
+StopTimer::~StopTimer() {
+    cancel();
+}
+
+void StopTimer::start(const Time deadline, std::atomic<bool>& stop) {
+    assert(!thread.joinable());
+
+    cancelled = false;
+
+    thread = std::thread([this, deadline, &stop] {
+        std::unique_lock<std::mutex> lock(mutex);
+
+        if (!condition.wait_until(lock, deadline, [this] { return cancelled; })) stop = true;
+    });
+}
+
+void StopTimer::cancel() {
+    if (!thread.joinable()) return;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        cancelled = true;
+    }
+
+    condition.notify_one();
+    thread.join();
+}
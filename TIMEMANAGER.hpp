@@ -0,0 +1,75 @@
+#pragma once
+#include "DEFINITION.hpp"
+#include "GAMESTATE.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#define SOFT_LIMIT_PERCENT 60 //Anteil der harten Grenze, nach dem keine neue Iteration mehr begonnen wird
+#define STABLE_ITERATIONS 4 //Nach so vielen Iterationen mit demselben besten Zug wird die weiche Grenze verkrzt
+#define STABLE_PERCENT 70 //Weiche Grenze bei stabilem besten Zug
+#define UNSTABLE_PERCENT 130 //Weiche Grenze, wenn sich der beste Zug in der letzten Iteration gendert hat
+#define SCORE_DROP 20 //Fllt die Bewertung an der Wurzel um mindestens so viel, wird die weiche Grenze verlngert
+#define SCORE_DROP_PERCENT 200 //Weiche Grenze nach einem solchen Einbruch
+#define MIN_HARD_LIMIT_PERCENT 50 //Die gemessene Latenz krzt die harte Grenze hchstens auf diesen Anteil von timeLimit
+
+/*Berechnet fr jeden Zug zwei Grenzen in Millisekunden ab start, gemessen mit der monotonen steady_clock.
+Die harte Grenze ist timeLimit abzglich der beobachteten Latenz zwischen dem Ende der Suche und dem Absenden des Zugs,
+an ihr setzt ein StopTimer das Stop-Flag der Suche. Die weiche Grenze wird nur zwischen zwei Iterationen geprft:
+Ist sie berschritten, reicht die Zeit meist nicht mehr fr eine vollstndige weitere Iteration.
+Sie wird verkrzt, wenn der beste Zug ber mehrere Iterationen stabil bleibt, und verlngert, wenn er wechselt
+oder die Bewertung einbricht. Ist das Ergebnis entschieden oder reicht die Suche bis zum Zuglimit, wird nicht weiter vertieft.*/
+class TimeManager {
+private:
+    const int timeLimit; //Bedenkzeit pro Zug abzglich einer festen Reserve (SearchConfig::timeLimit)
+    Time start;
+    Time searchEnd;
+    int hardLimit = 0;
+    int softLimit = 0;
+    int latency = 0; //Geschtzte Zeit vom Ende der Suche bis der Zug gesendet ist
+    int remainingTurns = 0; //Halbzge bis zum Zuglimit
+    Move lastBest;
+    int lastScore = 0;
+    int stableIterations = 0;
+
+public:
+    TimeManager(const int timeLimit);
+
+    void startSearch(const Time start, const GameState& gameState, const bool infinite); //Berechnet die Grenzen fr einen neuen Zug, infinite fr Pondering ohne Grenzen
+
+    int elapsed() const; //Millisekunden seit start
+
+    Time hardDeadline() const {
+        return start + MS(hardLimit);
+    }
+
+    bool nextIteration(const int depth, const Move& bestMove, const int score); //Nach einer vollstndigen Iteration: soll eine weitere begonnen werden?
+
+    void stopSearch(); //Merkt sich das Ende der Suche
+
+    void recordSend(const Time sent); //Misst die Latenz bis zum Absenden des Zugs und passt die harte Grenze knftiger Zge an
+};
+
+/*Wartet in einem eigenen Thread bis zu einem Zeitpunkt und setzt dann das Stop-Flag, das alle Suchthreads abfragen.
+So liest keiner der Suchthreads whrend der Suche die Uhr. cancel beendet den Thread vorzeitig, ohne das Flag zu setzen.*/
+class StopTimer {
+private:
+    std::thread thread;
+    std::mutex mutex;
+    std::condition_variable condition;
+    bool cancelled = false;
+
+public:
+    StopTimer() = default;
+
+    StopTimer(const StopTimer&) = delete;
+
+    StopTimer& operator=(const StopTimer&) = delete;
+
+    ~StopTimer();
+
+    void start(const Time deadline, std::atomic<bool>& stop); //Setzt stop zum Zeitpunkt deadline, falls vorher nicht cancel aufgerufen wird
+
+    void cancel(); //Beendet den wartenden Thread, ohne stop zu setzen
+};
@@ -1,19 +1,44 @@
 #include "TRANSPOSITIONTABLE.hpp"
 #include <assert.h>
 #include <cstdlib>
+#include <stdint.h>
 
 TranspositionTable::TranspositionTable() { //Konstruktor fr die TranspositionTable-Klasse
-    table = (Transposition*)std::calloc(TRANSPOSITION_TABLE_SIZE, sizeof(Transposition));
+    table = (TranspositionEntry*)std::calloc(TRANSPOSITION_TABLE_SIZE, sizeof(TranspositionEntry));
 }
 /*Initialisierung:
 Die Methode wird aufgerufen, wenn ein neues TranspositionTable-Objekt erstellt wird.
 Sie reserviert Speicherplatz fr die Transpositionstabelle, indem sie std::calloc verwendet.
 std::calloc allokiert Speicher fr eine bestimmte Anzahl von Elementen (in diesem Fall TRANSPOSITION_TABLE_SIZE) und initialisiert sie mit Nullen.
 Speicherplatz:
-Die Tabelle wird als Array von Transposition-Strukturen angelegt.
+Die Tabelle wird als Array von TranspositionEntry-Strukturen angelegt.
 Die Gre der Tabelle wird durch TRANSPOSITION_TABLE_SIZE festgelegt.
 Typumwandlung:
-Der Rckgabewert von std::calloc ist ein void*, daher wird er in einen Zeiger auf Transposition umgewandelt.*/
+Der Rckgabewert von std::calloc ist ein void*, daher wird er in einen Zeiger auf TranspositionEntry umgewandelt.*/
+
+uint64_t pack(const Transposition& transposition) { //Packt alle Felder auer hash in 64 Bit
+    assert(transposition.score >= INT16_MIN && transposition.score <= INT16_MAX);
+    assert(transposition.depth >= 0 && transposition.depth <= UINT8_MAX);
+    assert(transposition.turn >= 0 && transposition.turn <= UINT8_MAX);
+
+    return (uint64_t)(uint16_t)transposition.score
+        | (uint64_t)transposition.move.data << 16
+        | (uint64_t)transposition.depth << 32
+        | (uint64_t)transposition.turn << 40
+        | (uint64_t)transposition.type << 48;
+}
+
+Transposition unpack(const uint64_t hash, const uint64_t data) {
+    Transposition transposition;
+    transposition.type = (TranspositionType)((data >> 48) & 3);
+    transposition.hash = hash;
+    transposition.depth = (int)((data >> 32) & 0xFF);
+    transposition.score = (int16_t)(data & 0xFFFF);
+    transposition.move.data = (uint16_t)(data >> 16);
+    transposition.turn = (int)((data >> 40) & 0xFF);
+
+    return transposition;
+}
 
 TranspositionTable::~TranspositionTable() { //Dekonstruktor
     std::free(table);
@@ -49,16 +74,16 @@ R
 Die Funktion gibt den berechneten Index zurck, der verwendet wird, um den entsprechenden Eintrag in der Transpositionstabelle abzurufen.*/
 
 Transposition TranspositionTable::get(const uint64_t hash) const { //Ruft gespeicherte Eintrge aus der Tabelle ab
-    Transposition transposition = table[calcIndex(hash)];
+    const TranspositionEntry entry = table[calcIndex(hash)];
 
-    if (transposition.hash != hash) return { EMPTY };
+    if ((entry.key ^ entry.data) != hash || entry.data == 0) return { EMPTY };
 
-    return transposition;
+    return unpack(hash, entry.data);
 }
 /*Die Methode verwendet den Hashwert, um den Index in der Transpositionstabelle zu berechnen. Dies geschieht mithilfe der calcIndex-Funktion.
-Der Eintrag an diesem Index wird aus der Tabelle abgerufen und in der lokalen Variable transposition gespeichert.
-Wenn der Hashwert des abgerufenen Eintrags nicht mit dem ursprnglichen Hashwert bereinstimmt, wird ein leerer Transpositionseintrag zurckgegeben (mit dem Wert EMPTY).
-Andernfalls wird der gespeicherte Transpositionseintrag zurckgegeben.*/
+Der Eintrag an diesem Index wird aus der Tabelle abgerufen und in der lokalen Variable entry gespeichert.
+Wenn key ^ data nicht mit dem ursprnglichen Hashwert bereinstimmt (andere Stellung oder zwei Schreibvorgnge vermischt), wird ein leerer Transpositionseintrag zurckgegeben (mit dem Wert EMPTY).
+Andernfalls wird der gespeicherte Transpositionseintrag entpackt und zurckgegeben.*/
 
 bool replace(const Transposition& stored, const Transposition& replacement) { //Vergleicht Eintrge, um zu entscheiden, ob der neue Eintrag den gespeicherten Eintrag ersetzen soll
     if (stored.type == EMPTY) return true;
@@ -72,17 +97,78 @@ Wenn der neue Eintrag in einem sp
 Andernfalls wird der gespeicherte Eintrag beibehalten.*/
 
 void TranspositionTable::put(const Transposition& transposition) const { //Fgt der Tabelle einen neuen Eintrag hinzu
+    assert(transposition.type != EMPTY);
+
     int index = calcIndex(transposition.hash);
-    Transposition storedTransposition = table[index];
+    const TranspositionEntry entry = table[index];
+    Transposition storedTransposition = (entry.data == 0) ? Transposition{} : unpack(entry.key ^ entry.data, entry.data);
 
     if (replace(storedTransposition, transposition)) {
-        table[index] = transposition;
+        const uint64_t data = pack(transposition);
+        table[index] = { transposition.hash ^ data, data };
     }
 }
 /*Berechnung des Index:
 Der Hashwert der Position (transposition.hash) wird verwendet, um den Index in der Tabelle zu berechnen. Dies geschieht mit der calcIndex-Funktion.
 Der Index gibt an, an welcher Stelle der Eintrag in der Tabelle gespeichert werden soll.
 Vergleich mit dem gespeicherten Eintrag:
-Der aktuelle Eintrag an diesem Index (storedTransposition) wird abgerufen.
+Der aktuelle Eintrag an diesem Index wird abgerufen und entpackt (storedTransposition).
 Die Funktion replace wird aufgerufen, um zu berprfen, ob der neue Eintrag den gespeicherten Eintrag ersetzen sollte.
-Wenn ja, wird der neue Eintrag in der Tabelle aktualisiert.*/
\ No newline at end of file
+Wenn ja, wird der neue Eintrag gepackt und in der Tabelle aktualisiert.*/
+
+SearchingMoves::SearchingMoves() {
+    table = new std::atomic<uint64_t>[(1 << SEARCHING_MOVES_BITS) * SEARCHING_MOVES_WAYS];
+
+    for (int i = 0; i < (1 << SEARCHING_MOVES_BITS) * SEARCHING_MOVES_WAYS; ++i) table[i].store(0, std::memory_order_relaxed);
+}
+
+SearchingMoves::~SearchingMoves() {
+    delete[] table;
+}
+
+std::atomic<uint64_t>* bucket(std::atomic<uint64_t>* table, const uint64_t moveHash) { //Erster Eintrag des Buckets zu moveHash
+    return table + (moveHash >> (64 - SEARCHING_MOVES_BITS)) * SEARCHING_MOVES_WAYS;
+}
+
+bool SearchingMoves::isSearching(const uint64_t moveHash, const int depth) const {
+    if (depth < ABDADA_MIN_DEPTH) return false;
+
+    const std::atomic<uint64_t>* entries = bucket(table, moveHash);
+
+    for (int i = 0; i < SEARCHING_MOVES_WAYS; ++i) {
+        if (entries[i].load(std::memory_order_relaxed) == moveHash) return true;
+    }
+
+    return false;
+}
+
+void SearchingMoves::start(const uint64_t moveHash, const int depth) {
+    if (depth < ABDADA_MIN_DEPTH) return;
+
+    std::atomic<uint64_t>* entries = bucket(table, moveHash);
+
+    for (int i = 0; i < SEARCHING_MOVES_WAYS; ++i) {
+        const uint64_t entry = entries[i].load(std::memory_order_relaxed);
+
+        if (entry == moveHash) return;
+        if (entry == 0) {
+            entries[i].store(moveHash, std::memory_order_relaxed);
+            return;
+        }
+    }
+
+    entries[0].store(moveHash, std::memory_order_relaxed); //Bucket voll: der lteste Eintrag wird berschrieben
+}
+/*Zwischen load und store kann ein anderer Thread denselben freien Eintrag belegen. Dann fehlt einer der beiden Zge in der Tabelle
+und wird eventuell von zwei Threads gleichzeitig gesucht, das Ergebnis der Suche bleibt davon unberhrt.*/
+
+void SearchingMoves::finish(const uint64_t moveHash, const int depth) {
+    if (depth < ABDADA_MIN_DEPTH) return;
+
+    std::atomic<uint64_t>* entries = bucket(table, moveHash);
+
+    for (int i = 0; i < SEARCHING_MOVES_WAYS; ++i) {
+        uint64_t expected = moveHash;
+        entries[i].compare_exchange_strong(expected, 0, std::memory_order_relaxed);
+    }
+}
\ No newline at end of file
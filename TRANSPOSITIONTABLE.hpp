@@ -1,5 +1,6 @@
 #pragma once
 #include "DEFINITION.hpp"
+#include <atomic>
 #include <stdint.h>
 /*Eine Transpositionstabelle ist ein Cache von zuvor gesehenen Positionen und 
 den zugehrigen Bewertungen in einem Spielbaum, der von einer Schach-Engine generiert wird.
@@ -22,12 +23,21 @@ struct Transposition { //Wird verwendet um Informationen 
     int turn; //Die Zugnummer, bei der diese Position auftritt. Dies hilft, die Reihenfolge der Zge zu verfolgen.
 };
 
+/*So liegt ein Eintrag in der Tabelle: Alle Felder einer Transposition auer hash sind in data gepackt
+(score Bit 0 bis 15, move Bit 16 bis 31, depth Bit 32 bis 39, turn Bit 40 bis 47, type Bit 48 bis 49), gespeichert wird key = hash ^ data.
+Bei Lazy SMP schreiben mehrere Threads ohne Sperre in die Tabelle. Liest ein Thread key und data aus zwei verschiedenen Schreibvorgngen,
+passt key ^ data nicht mehr zum Hash und der Eintrag wird wie ein leerer behandelt.*/
+struct TranspositionEntry {
+    uint64_t key;
+    uint64_t data;
+};
+
 #define TRANSPOSITION_TABLE_BITS 20 //Konstante, die die Anzahl der Bits (20) festlegt, die zur Berechnung des Index in der Tabelle verwendet werden.
 #define TRANSPOSITION_TABLE_SIZE (1 << TRANSPOSITION_TABLE_BITS) //Berechnet die tatschliche Gre der Tabelle, indem sie 2^20 verwendet (1.048.576 Eintrge)
 
 class TranspositionTable {
 private:
-    Transposition* table;
+    TranspositionEntry* table;
 
 public:
     TranspositionTable();
@@ -37,4 +47,36 @@ public:
     void put(const Transposition& transposition) const; //Fgt einen neuen Eintrag in die Tabelle wenn er den gespeicherten Ersetzen soll
 
     ~TranspositionTable();
+};
+
+#define SEARCHING_MOVES_BITS 15 //Anzahl der Bits fr den Index der SearchingMoves-Tabelle (32.768 Buckets)
+#define SEARCHING_MOVES_WAYS 4 //Eintrge pro Bucket
+#define ABDADA_MIN_DEPTH 3 //Erst ab dieser Resttiefe werden Zge bei ABDADA zurckgestellt
+
+/*ABDADA: Merkt sich, welche Zge gerade von irgendeinem Thread durchsucht werden. Ein Zug wird durch den Hash der Stellung
+vor dem Zug und den Zug selbst gekennzeichnet (moveHash). Findet ein anderer Thread den Zug hier, stellt er ihn zurck
+und sucht zuerst die brigen Zge des Knotens. Die Tabelle ist wie die Transpositionstabelle ohne Sperre,
+ein verlorener oder veralteter Eintrag kostet nur doppelte Arbeit.*/
+class SearchingMoves {
+private:
+    std::atomic<uint64_t>* table;
+
+public:
+    SearchingMoves();
+
+    static uint64_t moveHash(const uint64_t hash, const Move& move) { //Kennung eines Zugs in einer Stellung
+        return hash ^ ((uint64_t)(move.data & 0xFFF) + 1) * 0x9E3779B97F4A7C15ULL;
+    }
+
+    bool isSearching(const uint64_t moveHash, const int depth) const; //Durchsucht gerade ein anderer Thread diesen Zug?
+
+    void start(const uint64_t moveHash, const int depth); //Trgt den Zug vor seiner Suche ein
+
+    void finish(const uint64_t moveHash, const int depth); //Entfernt den Zug nach seiner Suche
+
+    ~SearchingMoves();
+
+    SearchingMoves(const SearchingMoves&) = delete;
+
+    SearchingMoves& operator=(const SearchingMoves&) = delete;
 };
\ No newline at end of file